@@ -0,0 +1,390 @@
+#include "aoc/aoc.hpp"
+
+#include "day1.hpp"
+#include "day10.hpp"
+#include "day11.hpp"
+#include "day2.hpp"
+#include "day3.hpp"
+#include "day4.hpp"
+#include "day5.hpp"
+#include "day6.hpp"
+#include "day7.hpp"
+#include "day8.hpp"
+#include "day9.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Google Benchmark suite for the libaoc primitives and every day's `parse` and `partN`
+// functions. Primitives run on generated inputs of increasing size. Days run on the first
+// `lines` lines of their real input, where `lines:0` is the whole input. Days whose input
+// prefixes are not valid puzzles only run on the whole input.
+//
+// Usage: aoc_bench [--benchmark_...] [DATA_DIR]   (defaults to `data`)
+
+namespace {
+
+using aoc::i64;
+using aoc::u64;
+using aoc::usize;
+
+std::filesystem::path data_dir{"data"};
+
+// fixed seed so every run measures the same inputs
+std::mt19937_64 make_rng() {
+    return std::mt19937_64{0x5eed};
+}
+
+// ==========
+// PRIMITIVES
+// ==========
+
+// space separated numbers, like most puzzle lines
+std::string number_line(i64 count) {
+    auto rng = make_rng();
+    std::uniform_int_distribution<u64> dist{0, 99'999};
+
+    std::string line{};
+    for (i64 i = 0; i < count; ++i) {
+        if (i > 0) {
+            line += ' ';
+        }
+        line += std::to_string(dist(rng));
+    }
+    return line;
+}
+
+void split(benchmark::State& state) {
+    auto line = number_line(state.range(0));
+    for (auto _ : state) {
+        auto parts = aoc::split(line, ' ');
+        benchmark::DoNotOptimize(parts.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<i64>(line.size()));
+}
+BENCHMARK(split)->RangeMultiplier(8)->Range(8, 4096);
+
+void split_trim_discard(benchmark::State& state) {
+    // doubled separators leave empty fields for `DiscardEmpty` to drop
+    std::string line{"  "};
+    for (char c : number_line(state.range(0))) {
+        line += c;
+        if (c == ' ') {
+            line += ' ';
+        }
+    }
+    line += "  ";
+    for (auto _ : state) {
+        auto parts =
+            aoc::split(line, ' ', aoc::SplitOptions::Trim | aoc::SplitOptions::DiscardEmpty);
+        benchmark::DoNotOptimize(parts.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<i64>(line.size()));
+}
+BENCHMARK(split_trim_discard)->RangeMultiplier(8)->Range(8, 4096);
+
+void split_once(benchmark::State& state) {
+    // the separator sits `range(0)` bytes in, like a long `Game 1:` prefix
+    auto line = std::string(static_cast<usize>(state.range(0)), 'a') + ": " + number_line(8);
+    for (auto _ : state) {
+        auto parts = aoc::split_once(line, ": ");
+        benchmark::DoNotOptimize(parts);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<i64>(line.size()));
+}
+BENCHMARK(split_once)->RangeMultiplier(8)->Range(8, 4096);
+
+void trim(benchmark::State& state) {
+    auto padding = std::string(static_cast<usize>(state.range(0)), ' ');
+    auto line = padding + number_line(8) + padding;
+    for (auto _ : state) {
+        auto trimmed = aoc::trim(line);
+        benchmark::DoNotOptimize(trimmed);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<i64>(line.size()));
+}
+BENCHMARK(trim)->RangeMultiplier(8)->Range(8, 4096);
+
+void decode_digit(benchmark::State& state) {
+    // a mix of digits, spelled digits and filler, decoded at every position like day 1
+    constexpr std::array<std::string_view, 12> TOKENS{
+        "1", "2", "7", "one", "two", "three", "four", "five", "six", "seven", "x", "q"};
+    auto rng = make_rng();
+    std::uniform_int_distribution<usize> dist{0, TOKENS.size() - 1};
+
+    std::string line{};
+    while (line.size() < static_cast<usize>(state.range(0))) {
+        line += TOKENS.at(dist(rng));
+    }
+
+    for (auto _ : state) {
+        int sum{};
+        for (usize i = 0; i < line.size(); ++i) {
+            sum += aoc::decode_digit(line, i).value_or(0);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<i64>(line.size()));
+}
+BENCHMARK(decode_digit)->RangeMultiplier(4)->Range(16, 1024);
+
+// square grid of `.` and `#`, the size of the grid puzzles at `n = 140`
+std::vector<std::string> grid_lines(i64 n) {
+    auto rng = make_rng();
+    std::bernoulli_distribution wall{0.2};
+
+    std::vector<std::string> lines(static_cast<usize>(n));
+    for (auto& line : lines) {
+        for (i64 x = 0; x < n; ++x) {
+            line += wall(rng) ? '#' : '.';
+        }
+    }
+    return lines;
+}
+
+void make_grid(benchmark::State& state) {
+    auto lines = grid_lines(state.range(0));
+    for (auto _ : state) {
+        auto grid = aoc::make_grid(lines);
+        benchmark::DoNotOptimize(grid);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+BENCHMARK(make_grid)->RangeMultiplier(2)->Range(16, 512);
+
+void grid_adjacent(benchmark::State& state) {
+    auto grid = aoc::make_grid(grid_lines(state.range(0)));
+    for (auto _ : state) {
+        usize count{};
+        for (usize y = 0; y < grid.height(); ++y) {
+            for (usize x = 0; x < grid.width(); ++x) {
+                count += grid.adjacent(x, y).size();
+            }
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+BENCHMARK(grid_adjacent)->RangeMultiplier(2)->Range(16, 512);
+
+void hash_combine(benchmark::State& state) {
+    auto rng = make_rng();
+    std::uniform_int_distribution<usize> dist{0, 1023};
+    std::vector<aoc::Coord> coords(static_cast<usize>(state.range(0)));
+    for (auto& c : coords) {
+        c = {dist(rng), dist(rng)};
+    }
+
+    for (auto _ : state) {
+        usize seed{};
+        for (const auto& c : coords) {
+            aoc::hash_combine(seed, c.x, c.y);
+        }
+        benchmark::DoNotOptimize(seed);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(hash_combine)->RangeMultiplier(8)->Range(64, 1 << 15);
+
+// ====
+// DAYS
+// ====
+
+// Writes the first `lines` lines of `source` to a scratch file, so `parse` can read it like
+// a regular input. Returns `source` itself for 0 or when it has no more than `lines` lines.
+std::filesystem::path prefix_input(const std::filesystem::path& source, i64 lines) {
+    if (lines <= 0) {
+        return source;
+    }
+
+    auto input = aoc::open(source);
+
+    std::vector<std::string> kept{};
+    std::string line{};
+    while (std::getline(input, line)) {
+        if (static_cast<i64>(kept.size()) == lines) {
+            auto dir = std::filesystem::temp_directory_path() / "aoc_bench";
+            std::filesystem::create_directories(dir);
+            auto path = dir / fmt::format("{}_{}.txt", source.stem().string(), lines);
+
+            std::ofstream out{path};
+            for (const auto& l : kept) {
+                out << l << '\n';
+            }
+            return path;
+        }
+        kept.push_back(line);
+    }
+    return source;
+}
+
+// calls `parse(path, mr)` for days that take a memory resource, or `parse(path)`
+template<auto Parse>
+auto parse_input(
+    const std::filesystem::path& path,
+    std::pmr::memory_resource* mr = std::pmr::get_default_resource()
+) {
+    using Path = const std::filesystem::path&;
+    if constexpr (std::is_invocable_v<decltype(Parse), Path, std::pmr::memory_resource*>) {
+        return Parse(path, mr);
+    } else {
+        return Parse(path);
+    }
+}
+
+template<auto Parse>
+void parse(benchmark::State& state, std::string_view day) {
+    auto path = prefix_input(data_dir / fmt::format("{}.txt", day), state.range(0));
+    auto bytes = static_cast<i64>(std::filesystem::file_size(path));
+
+    for (auto _ : state) {
+        auto input = parse_input<Parse>(path);
+        benchmark::DoNotOptimize(input);
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+// same as `parse`, into an arena that is reset after every iteration
+template<auto Parse>
+void parse_arena(benchmark::State& state, std::string_view day) {
+    auto path = prefix_input(data_dir / fmt::format("{}.txt", day), state.range(0));
+    auto bytes = static_cast<i64>(std::filesystem::file_size(path));
+
+    aoc::Arena arena{};
+    for (auto _ : state) {
+        {
+            auto input = Parse(path, &arena);
+            benchmark::DoNotOptimize(input);
+        }
+        arena.reset();
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+template<auto Parse, auto Part>
+void solve(benchmark::State& state, std::string_view day) {
+    auto path = prefix_input(data_dir / fmt::format("{}.txt", day), state.range(0));
+    auto bytes = static_cast<i64>(std::filesystem::file_size(path));
+    const auto input = parse_input<Parse>(path);
+
+    for (auto _ : state) {
+        auto result = Part(input);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+// registers `dayN/parse` and `dayN/partN` for each input size, in lines (0 for all)
+template<auto Parse, auto... Parts>
+void register_day(std::string_view day, std::initializer_list<i64> sizes) {
+    auto configure = [sizes](benchmark::internal::Benchmark* b) {
+        b->ArgName("lines")->Unit(benchmark::kMicrosecond);
+        for (auto n : sizes) {
+            b->Arg(n);
+        }
+    };
+
+    configure(benchmark::RegisterBenchmark(
+        fmt::format("{}/parse", day).c_str(), parse<Parse>, day
+    ));
+
+    int part{};
+    (configure(benchmark::RegisterBenchmark(
+         fmt::format("{}/part{}", day, ++part).c_str(), solve<Parse, Parts>, day
+     )),
+     ...);
+}
+
+// parses and solves in one pass over a generator, for comparison with `parse` plus `partN`
+template<auto Solve>
+void streamed(benchmark::State& state, std::string_view day) {
+    auto path = prefix_input(data_dir / fmt::format("{}.txt", day), state.range(0));
+    auto bytes = static_cast<i64>(std::filesystem::file_size(path));
+
+    for (auto _ : state) {
+        auto result = Solve(path);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+template<auto Parse>
+void register_arena(std::string_view day, std::initializer_list<i64> sizes) {
+    auto* b = benchmark::RegisterBenchmark(
+        fmt::format("{}/parse_arena", day).c_str(), parse_arena<Parse>, day
+    );
+    b->ArgName("lines")->Unit(benchmark::kMicrosecond);
+    for (auto n : sizes) {
+        b->Arg(n);
+    }
+}
+
+template<auto Solve>
+void register_streamed(std::string_view name, std::initializer_list<i64> sizes) {
+    auto day = name.substr(0, name.find('/'));
+    auto* b = benchmark::RegisterBenchmark(std::string{name}.c_str(), streamed<Solve>, day);
+    b->ArgName("lines")->Unit(benchmark::kMicrosecond);
+    for (auto n : sizes) {
+        b->Arg(n);
+    }
+}
+
+auto day2_streamed(const std::filesystem::path& path) {
+    return day2::sum_possible(day2::parse_games(path));
+}
+
+auto day4_streamed(const std::filesystem::path& path) {
+    return day4::sum_points(day4::parse_cards(path));
+}
+
+auto day9_streamed(const std::filesystem::path& path) {
+    return day9::sum_extrapolated(day9::parse_readings(path), day9::Reading::Direction::Future);
+}
+
+void register_days() {
+    // prefixes of days 5, 6, 8 and 10 are not valid puzzles, so they only run in full
+    register_day<day1::parse, day1::part1>("day1", {10, 100, 0});
+    register_day<day2::parse, day2::part1, day2::part2>("day2", {10, 0});
+    register_day<day3::parse, day3::part1, day3::part2>("day3", {14, 0});
+    register_day<day4::parse, day4::part1, day4::part2>("day4", {20, 0});
+    register_day<day5::parse, day5::part1, day5::part2>("day5", {0});
+    register_day<day6::parse, day6::part1, day6::part2>("day6", {0});
+    register_day<day7::parse, day7::part1, day7::part2>("day7", {10, 100, 0});
+    register_day<day8::parse, day8::part1, day8::part2>("day8", {0});
+    register_day<day9::parse, day9::part1, day9::part2>("day9", {20, 0});
+    register_day<day10::parse, day10::part1, day10::part2>("day10", {0});
+    register_day<day11::parse, day11::part1, day11::part2>("day11", {14, 0});
+
+    register_arena<day4::parse>("day4", {20, 0});
+    register_arena<day8::parse>("day8", {0});
+
+    register_streamed<day2_streamed>("day2/streamed1", {10, 0});
+    register_streamed<day4_streamed>("day4/streamed1", {20, 0});
+    register_streamed<day9_streamed>("day9/streamed1", {20, 0});
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    // day parsers log at info level, which would bury the results
+    spdlog::set_level(spdlog::level::warn);
+    if (argc > 1) {
+        data_dir = argv[1];
+    }
+
+    register_days();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+}
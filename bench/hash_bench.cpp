@@ -0,0 +1,493 @@
+#include "aoc/aoc.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Measures throughput and distribution quality of every hasher used in the tree, alongside
+// a murmur3 finalizer and wyhash for comparison. Keys are extracted from the
+// real puzzle inputs so the numbers reflect what the solvers actually put in hash tables.
+//
+// Usage: hash_bench [DATA_DIR]   (defaults to `data`)
+
+namespace {
+
+using aoc::f64;
+using aoc::u64;
+using aoc::usize;
+
+using Words = std::array<u64, 2>;  // a coordinate, or a (start, length) range
+using WordPairs = std::array<u64, 4>;  // a pair of coordinates
+
+// =======
+// MIXERS
+// =======
+
+// murmur3 64-bit finalizer
+constexpr u64 fmix64(u64 k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+constexpr u64 WY_P0 = 0xa0761d6478bd642fULL;
+constexpr u64 WY_P1 = 0xe7037ed1a0b428dbULL;
+
+// 64x64 -> 128 bit multiply folded to 64 bits (wyhash `_wymix`), written portably
+// so it builds without `__int128`
+constexpr u64 wymix(u64 a, u64 b) {
+    const u64 a_lo = a & 0xffffffffULL;
+    const u64 a_hi = a >> 32;
+    const u64 b_lo = b & 0xffffffffULL;
+    const u64 b_hi = b >> 32;
+
+    const u64 ll = a_lo * b_lo;
+    const u64 lh = a_lo * b_hi;
+    const u64 hl = a_hi * b_lo;
+    const u64 hh = a_hi * b_hi;
+
+    const u64 mid = (ll >> 32) + (lh & 0xffffffffULL) + (hl & 0xffffffffULL);
+    const u64 lo = (ll & 0xffffffffULL) | (mid << 32);
+    const u64 hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+
+    return lo ^ hi;
+}
+
+// ================
+// HASHERS: WORDS
+// ================
+
+// `std::hash` specializations for `Coord` in day3/day10 and `Seed` in day5
+u64 xor_shift(const Words& k) {
+    return std::hash<usize>{}(k[0]) ^ (std::hash<usize>{}(k[1]) << 1);
+}
+
+// `std::hash<aoc::Coord>`
+u64 boost_combine(const Words& k) {
+    return std::hash<aoc::Coord>{}({k[0], k[1]});
+}
+
+u64 murmur_fmix(const Words& k) {
+    return fmix64(fmix64(k[0]) ^ k[1]);
+}
+
+// wyhash of the 16 key bytes with seed 0, including the final `wymix(secret ^ len, ...)`
+u64 wy_mix(const Words& k) {
+    return wymix(WY_P1 ^ sizeof(Words), wymix(k[0] ^ WY_P1, k[1] ^ WY_P0));
+}
+
+// ====================
+// HASHERS: WORD PAIRS
+// ====================
+
+// `std::hash<std::pair<aoc::Coord, aoc::Coord>>` in day11
+u64 boost_combine_pair(const WordPairs& k) {
+    size_t seed{};
+    aoc::hash_combine(seed, aoc::Coord{k[0], k[1]}, aoc::Coord{k[2], k[3]});
+    return seed;
+}
+
+u64 murmur_fmix_pair(const WordPairs& k) {
+    u64 h{};
+    for (auto w : k) {
+        h = fmix64(h ^ w);
+    }
+    return h;
+}
+
+// wyhash of the 32 key bytes with seed 0: one 16 byte round, then the tail and final mix
+u64 wy_mix_pair(const WordPairs& k) {
+    const u64 seed = wymix(k[0] ^ WY_P1, k[1] ^ WY_P0);
+    return wymix(WY_P1 ^ sizeof(WordPairs), wymix(k[2] ^ WY_P1, k[3] ^ seed));
+}
+
+// ==================
+// HASHERS: STRINGS
+// ==================
+
+// `std::hash<std::string>`, used by the day8 network
+u64 std_string(const std::string& k) {
+    return std::hash<std::string>{}(k);
+}
+
+u64 fnv1a(const std::string& k) {
+    u64 h = 0xcbf29ce484222325ULL;
+    for (auto c : k) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+u64 fnv1a_fmix(const std::string& k) {
+    return fmix64(fnv1a(k));
+}
+
+// not wyhash itself, which reads 16 byte rounds and has its own tail handling: each 8 byte
+// block of the key goes through the wyhash mixer on its own
+u64 wymix_blocks(const std::string& k) {
+    u64 h = WY_P0 ^ k.size();
+    for (usize i = 0; i < k.size(); i += sizeof(u64)) {
+        u64 block{};
+        std::memcpy(&block, k.data() + i, std::min(sizeof(u64), k.size() - i));
+        h = wymix(block ^ WY_P1, h);
+    }
+    return wymix(h ^ WY_P0, WY_P1);
+}
+
+// ==========
+// MEASURING
+// ==========
+
+volatile u64 SINK{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+template<typename K>
+using hash_fn = u64 (*)(const K&);
+
+template<typename K, hash_fn<K> Fn>
+f64 ns_per_key(const std::vector<K>& keys) {
+    using clock = std::chrono::steady_clock;
+    constexpr auto min_duration = std::chrono::milliseconds(50);
+
+    u64 acc{};
+    usize rounds{};
+    const auto start = clock::now();
+    auto elapsed = clock::duration{};
+    do {
+        for (const auto& k : keys) {
+            acc += Fn(k);
+        }
+        ++rounds;
+        elapsed = clock::now() - start;
+    } while (elapsed < min_duration);
+    SINK = SINK ^ acc;
+
+    auto ns = std::chrono::duration<f64, std::nano>(elapsed).count();
+    return ns / static_cast<f64>(rounds * keys.size());
+}
+
+template<typename K>
+struct Hasher {
+    std::string_view name{};
+    hash_fn<K> hash{};
+    f64 (*throughput)(const std::vector<K>&){};
+};
+
+template<typename K, hash_fn<K> Fn>
+constexpr Hasher<K> make_hasher(std::string_view name) {
+    return {name, Fn, &ns_per_key<K, Fn>};
+}
+
+template<usize N>
+usize bit_count(const std::array<u64, N>&) {
+    return N * 64;
+}
+
+usize bit_count(const std::string& s) {
+    return s.size() * 8;
+}
+
+template<usize N>
+std::array<u64, N> flip_bit(std::array<u64, N> k, usize bit) {
+    k.at(bit / 64) ^= 1ULL << (bit % 64);
+    return k;
+}
+
+std::string flip_bit(std::string k, usize bit) {
+    k.at(bit / 8) = static_cast<char>(k.at(bit / 8) ^ (1 << (bit % 8)));
+    return k;
+}
+
+struct BucketStats {
+    f64 quality{};
+    usize max_load{};
+};
+
+// Bucket quality as given in the "Red Dragon" book, where 1.0 is what a uniformly random
+// hash achieves and larger values mean more probing per lookup. `mask_buckets` selects
+// between power of two tables indexed by the low bits (MSVC, abseil) and prime sized tables
+// indexed by modulo (libstdc++, libc++).
+BucketStats bucket_stats(const std::vector<u64>& hashes, bool mask_buckets) {
+    auto n = hashes.size();
+    usize m = 1;
+    if (mask_buckets) {
+        while (m < n) {
+            m <<= 1;
+        }
+    } else {
+        auto is_prime = [](usize v) {
+            if (v < 2) {
+                return false;
+            }
+            for (usize d = 2; d * d <= v; ++d) {
+                if (v % d == 0) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        m = std::max<usize>(n, 2);
+        while (!is_prime(m)) {
+            ++m;
+        }
+    }
+
+    std::vector<usize> buckets(m);
+    for (auto h : hashes) {
+        auto idx = mask_buckets ? (h & (m - 1)) : (h % m);
+        buckets[idx]++;
+    }
+
+    f64 sum{};
+    for (auto b : buckets) {
+        sum += static_cast<f64>(b) * static_cast<f64>(b + 1) / 2.0;
+    }
+    auto nf = static_cast<f64>(n);
+    auto mf = static_cast<f64>(m);
+    auto expected = (nf / (2.0 * mf)) * (nf + 2.0 * mf - 1.0);
+
+    return {sum / expected, std::ranges::max(buckets)};
+}
+
+struct AvalancheStats {
+    f64 mean_bias{};
+    f64 max_bias{};
+};
+
+// Flips every input bit of a sample of keys and records how often each output bit changes.
+// Bias is |2p - 1| per (input bit, output bit) pair: 0 is ideal, 1 means the output bit
+// never (or always) reacts to that input bit.
+template<typename K>
+AvalancheStats avalanche(const std::vector<K>& keys, hash_fn<K> fn) {
+    constexpr usize max_samples = 512;
+    constexpr usize out_bits = 64;
+
+    std::mt19937_64 rng{0x5eed};
+    std::uniform_int_distribution<usize> pick{0, keys.size() - 1};
+
+    usize in_bits{};
+    for (const auto& k : keys) {
+        in_bits = std::max(in_bits, bit_count(k));
+    }
+
+    std::vector<usize> flips(in_bits * out_bits);
+    std::vector<usize> trials(in_bits);
+    for (usize s = 0; s < std::min(max_samples, keys.size()); ++s) {
+        const auto& key = keys[pick(rng)];
+        auto h = fn(key);
+        for (usize i = 0; i < bit_count(key); ++i) {
+            auto diff = h ^ fn(flip_bit(key, i));
+            for (usize j = 0; j < out_bits; ++j) {
+                flips[i * out_bits + j] += (diff >> j) & 1;
+            }
+            trials[i]++;
+        }
+    }
+
+    AvalancheStats result{};
+    usize count{};
+    for (usize i = 0; i < in_bits; ++i) {
+        if (trials[i] == 0) {
+            continue;
+        }
+        for (usize j = 0; j < out_bits; ++j) {
+            auto p = static_cast<f64>(flips[i * out_bits + j]) / static_cast<f64>(trials[i]);
+            auto bias = std::abs(2.0 * p - 1.0);
+            result.mean_bias += bias;
+            result.max_bias = std::max(result.max_bias, bias);
+            ++count;
+        }
+    }
+    if (count > 0) {
+        result.mean_bias /= static_cast<f64>(count);
+    }
+
+    return result;
+}
+
+template<typename K>
+void evaluate(std::string_view title, std::vector<K> keys, const std::vector<Hasher<K>>& hashers) {
+    std::ranges::sort(keys);
+    auto [first, last] = std::ranges::unique(keys);
+    keys.erase(first, last);
+
+    fmt::println("\n{} ({} distinct keys)\n", title, keys.size());
+    if (keys.empty()) {
+        fmt::println("  no keys, skipping");
+        return;
+    }
+
+    fmt::println(
+        "  {:<22} {:>8} {:>10} {:>12} {:>9} {:>11} {:>8} {:>10} {:>9}",
+        "hasher",
+        "ns/key",
+        "collisions",
+        "prime:qual",
+        "prime:max",
+        "pow2:qual",
+        "pow2:max",
+        "aval:mean",
+        "aval:max"
+    );
+
+    for (const auto& hasher : hashers) {
+        std::vector<u64> hashes{};
+        hashes.reserve(keys.size());
+        std::ranges::transform(keys, std::back_inserter(hashes), hasher.hash);
+
+        auto prime = bucket_stats(hashes, false);
+        auto pow2 = bucket_stats(hashes, true);
+
+        std::ranges::sort(hashes);
+        usize collisions{};
+        for (usize i = 1; i < hashes.size(); ++i) {
+            if (hashes[i] == hashes[i - 1]) {
+                ++collisions;
+            }
+        }
+
+        auto aval = avalanche(keys, hasher.hash);
+        auto ns = hasher.throughput(keys);
+
+        fmt::println(
+            "  {:<22} {:>8.3f} {:>10} {:>12.3f} {:>9} {:>11.3f} {:>8} {:>10.3f} {:>9.3f}",
+            hasher.name,
+            ns,
+            collisions,
+            prime.quality,
+            prime.max_load,
+            pow2.quality,
+            pow2.max_load,
+            aval.mean_bias,
+            aval.max_bias
+        );
+    }
+}
+
+// =========
+// KEY SETS
+// =========
+
+std::vector<std::string> read_lines(const std::filesystem::path& path) {
+    auto input = aoc::open(path);
+    std::vector<std::string> lines{};
+    std::string line{};
+    while (std::getline(input, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+template<typename Pred>
+std::vector<Words> grid_coords(const std::vector<std::string>& lines, Pred pred) {
+    std::vector<Words> result{};
+    for (usize y = 0; y < lines.size(); ++y) {
+        for (usize x = 0; x < lines[y].size(); ++x) {
+            if (pred(lines[y][x])) {
+                result.push_back({x, y});
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<Words> day5_ranges(const std::vector<std::string>& lines) {
+    auto to_nums = [](std::string_view s) {
+        std::vector<u64> nums{};
+        for (auto sv : aoc::split(s, ' ', aoc::SplitOptions::DiscardEmpty)) {
+            nums.push_back(std::stoull(std::string{sv}));
+        }
+        return nums;
+    };
+
+    std::vector<Words> result{};
+    for (const auto& line : lines) {
+        if (line.starts_with("seeds:")) {
+            auto nums = to_nums(aoc::split_once(line, ": ").value().second);
+            for (usize i = 0; i + 1 < nums.size(); i += 2) {
+                result.push_back({nums[i], nums[i + 1]});
+            }
+        } else if (!line.empty() && std::isdigit(static_cast<unsigned char>(line.front()))) {
+            // (src, length) of each mapping range
+            auto nums = to_nums(line);
+            AOC_ASSERT(nums.size() == 3, "Mapping should have exactly 3 numbers");
+            result.push_back({nums[1], nums[2]});
+        }
+    }
+    return result;
+}
+
+std::vector<std::string> day8_nodes(const std::vector<std::string>& lines) {
+    std::vector<std::string> result{};
+    for (const auto& line : lines) {
+        if (auto splits = aoc::split_once(line, " = ")) {
+            result.emplace_back(splits->first);
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::filesystem::path data{argc > 1 ? argv[1] : "data"};
+
+    const std::vector<Hasher<Words>> word_hashers{
+        make_hasher<Words, xor_shift>("xor-shift (day3/5/10)"),
+        make_hasher<Words, boost_combine>("hash_combine (aoc)"),
+        make_hasher<Words, murmur_fmix>("murmur3 fmix64"),
+        make_hasher<Words, wy_mix>("wyhash"),
+    };
+    const std::vector<Hasher<WordPairs>> pair_hashers{
+        make_hasher<WordPairs, boost_combine_pair>("hash_combine (day11)"),
+        make_hasher<WordPairs, murmur_fmix_pair>("murmur3 fmix64"),
+        make_hasher<WordPairs, wy_mix_pair>("wyhash"),
+    };
+    const std::vector<Hasher<std::string>> string_hashers{
+        make_hasher<std::string, std_string>("std::hash (day8)"),
+        make_hasher<std::string, fnv1a>("fnv-1a"),
+        make_hasher<std::string, fnv1a_fmix>("fnv-1a + fmix64"),
+        make_hasher<std::string, wymix_blocks>("wymix per 8 bytes"),
+    };
+
+    auto day3 = read_lines(data / "day3.txt");
+    auto symbols = grid_coords(day3, [](char c) {
+        return c != '.' && !std::isdigit(static_cast<unsigned char>(c));
+    });
+    evaluate("day3 symbol coordinates", symbols, word_hashers);
+    auto all_tiles = grid_coords(day3, [](char) { return true; });
+    evaluate("day3 all tile coordinates", all_tiles, word_hashers);
+
+    auto day10 = read_lines(data / "day10.txt");
+    auto pipes = grid_coords(day10, [](char c) { return c != '.'; });
+    evaluate("day10 pipe coordinates", pipes, word_hashers);
+
+    auto day11 = read_lines(data / "day11.txt");
+    auto galaxies = grid_coords(day11, [](char c) { return c == '#'; });
+    evaluate("day11 galaxy coordinates", galaxies, word_hashers);
+
+    std::vector<WordPairs> galaxy_pairs{};
+    for (usize i = 0; i < galaxies.size(); ++i) {
+        for (usize j = i + 1; j < galaxies.size(); ++j) {
+            const auto& a = galaxies[i];
+            const auto& b = galaxies[j];
+            galaxy_pairs.push_back({a[0], a[1], b[0], b[1]});
+        }
+    }
+    evaluate("day11 galaxy pairs", galaxy_pairs, pair_hashers);
+
+    auto day5 = read_lines(data / "day5.txt");
+    evaluate("day5 seed and map ranges", day5_ranges(day5), word_hashers);
+
+    auto day8 = read_lines(data / "day8.txt");
+    evaluate("day8 node names", day8_nodes(day8), string_hashers);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "aoc/aoc.hpp"
+
+#include <filesystem>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace day1 {
+
+inline std::vector<std::string> parse(const std::filesystem::path& path) {
+    auto input = aoc::open(path);
+
+    std::vector<std::string> lines{};
+    std::string line{};
+    while (std::getline(input, line)) {
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+
+inline int part1(const std::vector<std::string>& lines) {
+    std::vector<int> nums{};
+    for (const auto& line : lines) {
+        std::optional<int> x{};
+        std::optional<int> y{};
+
+        // find first digit
+        for (size_t i = 0; i < line.length(); i++) {
+            x = aoc::decode_digit(line, i);
+            if (x.has_value()) {
+                break;
+            }
+        }
+
+        // find last digit
+        for (size_t i = line.length(); i-- > 0;) {
+            y = aoc::decode_digit(line, i);
+            if (y.has_value()) {
+                break;
+            }
+        }
+
+        auto num = x.value() * 10 + y.value();
+        nums.push_back(num);
+    }
+
+    return std::reduce(nums.begin(), nums.end());
+}
+
+}  // namespace day1
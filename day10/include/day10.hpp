@@ -2,8 +2,10 @@
 
 #include "aoc/aoc.hpp"
 
+#include <filesystem>
 #include <queue>
 #include <unordered_set>
+#include <vector>
 
 namespace day10 {
 
@@ -127,7 +129,7 @@ public:
         auto dx = static_cast<int64_t>(to.x) - static_cast<int64_t>(from.x);
         auto dy = static_cast<int64_t>(to.y) - static_cast<int64_t>(from.y);
 
-        AOC_ASSERT(
+        AOC_DEBUG_ASSERT(
             (std::abs(dx) + std::abs(dy)) == 1,
             "coordinates must be adjacent in a cardinal direction"
         );
@@ -205,8 +207,8 @@ public:
     }
 
     [[nodiscard]]
-    std::vector<Coord> adjacent(Coord pos) const {
-        std::vector<Coord> result{};
+    aoc::SmallVector<Coord, 4> adjacent(Coord pos) const {
+        aoc::SmallVector<Coord, 4> result{};
 
         auto push_coord = [this, &result](const Coord& src, const Coord& dst) {
             if (is_adjacent(src, dst)) {
@@ -419,4 +421,23 @@ private:
     std::unordered_set<Coord> _loop{};
 };
 
+inline Maze parse(const std::filesystem::path& path) {
+    auto input = aoc::open(path);
+    std::vector<std::string> lines{};
+    std::string line{};
+    while (std::getline(input, line)) {
+        lines.push_back(line);
+    }
+
+    return Maze::parse(lines);
+}
+
+inline size_t part1(const Maze& maze) {
+    return maze.furthest();
+}
+
+inline size_t part2(const Maze& maze) {
+    return maze.enclosed();
+}
+
 }  // namespace day10
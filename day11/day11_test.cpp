@@ -105,3 +105,12 @@ TEST(Day11, GalaxyMapPairMinDistance) {
         EXPECT_EQ(sum, expected) << "with expansion factor " << factor;
     }
 }
+
+TEST(Day11, SumDistances) {
+    const auto g = day11::make_galaxy_map(MAP_DATA);
+
+    EXPECT_EQ(day11::sum_distances(g, 1), 374);
+    EXPECT_EQ(day11::sum_distances(g, 10), 1030);
+    EXPECT_EQ(day11::sum_distances(g, 100), 8410);
+    EXPECT_EQ(g.expansion_factor(), 0);
+}
@@ -2,6 +2,7 @@
 
 #include "aoc/aoc.hpp"
 
+#include <filesystem>
 #include <unordered_set>
 
 namespace std {
@@ -24,18 +25,6 @@ using aoc::Coord;
 using aoc::Grid;
 using aoc::range_val;
 
-inline bool crosses_row(size_t row, const Coord& from, const Coord& to) {
-    auto lo = std::min(from.y, to.y);
-    auto hi = std::max(from.y, to.y);
-    return lo < row && row < hi;
-}
-
-inline bool crosses_col(size_t col, const Coord& from, const Coord& to) {
-    auto lo = std::min(from.x, to.x);
-    auto hi = std::max(from.x, to.x);
-    return lo < col && col < hi;
-}
-
 class GalaxyMap : public Grid<char> {
 public:
     friend GalaxyMap make_galaxy_map(const std::vector<std::string>&);
@@ -47,20 +36,25 @@ public:
 
     [[nodiscard]]
     size_t min_distance(const Coord& from, const Coord& to) const override {
+        return min_distance(from, to, _expansion_factor);
+    }
+
+    // distance with every empty row and column `expansion_factor` times as wide, without
+    // changing the map's own factor
+    [[nodiscard]]
+    size_t min_distance(const Coord& from, const Coord& to, size_t expansion_factor) const {
         auto distance = Grid<char>::min_distance(from, to);
-        if (_expansion_factor == 0) {
+        if (expansion_factor == 0) {
             return distance;
         }
 
-        auto factor = _expansion_factor == 1 ? 1 : _expansion_factor - 1;
+        auto factor = expansion_factor == 1 ? 1 : expansion_factor - 1;
 
+        // the expansion sets are sorted, so crossings are the entries strictly between
+        // the two coordinates on each axis
         size_t count{};
-        count += std::ranges::count_if(_expand_rows, [&from, &to](auto row) {
-            return crosses_row(row, from, to);
-        });
-        count += std::ranges::count_if(_expand_cols, [&from, &to](auto col) {
-            return crosses_col(col, from, to);
-        });
+        count += count_between(_expand_rows, from.y, to.y);
+        count += count_between(_expand_cols, from.x, to.x);
 
         return distance + (count * factor);
     }
@@ -92,6 +86,15 @@ public:
     }
 
 private:
+    static size_t count_between(const aoc::FlatSet<size_t>& set, size_t a, size_t b) {
+        auto lo = std::min(a, b);
+        auto hi = std::max(a, b);
+        if (hi - lo < 2) {
+            return 0;
+        }
+        return static_cast<size_t>(set.lower_bound(hi) - set.upper_bound(lo));
+    }
+
     void cache_galaxy_coords() {
         _galaxies.clear();
         for (size_t x = 0; x < width(); ++x) {
@@ -132,8 +135,8 @@ private:
 
     std::vector<Coord> _galaxies{};
     size_t _expansion_factor{};
-    std::unordered_set<size_t> _expand_cols{};
-    std::unordered_set<size_t> _expand_rows{};
+    aoc::FlatSet<size_t> _expand_cols{};
+    aoc::FlatSet<size_t> _expand_rows{};
 };
 
 inline GalaxyMap make_galaxy_map(
@@ -145,4 +148,43 @@ inline GalaxyMap make_galaxy_map(
     return g;
 }
 
+inline GalaxyMap parse(const std::filesystem::path& path) {
+    auto input = aoc::open(path);
+    std::vector<std::string> lines{};
+
+    std::string line{};
+    while (std::getline(input, line)) {
+        lines.push_back(line);
+    }
+
+    return make_galaxy_map(lines);
+}
+
+// every galaxy sums its distances to the ones after it, rows of the pair triangle are spread
+// over the thread pool
+inline size_t sum_distances(const GalaxyMap& map, size_t expansion_factor) {
+    const auto& galaxies = map.galaxy_coords();
+    return aoc::parallel_reduce(
+        0,
+        galaxies.size(),
+        size_t{},
+        [&map, &galaxies, expansion_factor](size_t i) {
+            size_t sum{};
+            for (size_t j = i + 1; j < galaxies.size(); ++j) {
+                sum += map.min_distance(galaxies[i], galaxies[j], expansion_factor);
+            }
+            return sum;
+        },
+        std::plus<>{}
+    );
+}
+
+inline size_t part1(const GalaxyMap& map) {
+    return sum_distances(map, 1);
+}
+
+inline size_t part2(const GalaxyMap& map) {
+    return sum_distances(map, 1'000'000);
+}
+
 }  // namespace day11
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "aoc/aoc.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <ranges>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace day2 {
+
+using Colors = aoc::static_map<"red", "green", "blue">;
+
+struct GameSet {
+    int red{};
+    int green{};
+    int blue{};
+};
+
+class Game {
+public:
+    static Game parse(const std::string& s) {
+        Game game{};
+
+        auto [prefix, body] = aoc::split_once(s, ": ").value();
+        auto [lit, numstr] = aoc::split_once(prefix, ' ').value();
+        AOC_ASSERTF(lit == "Game", "Unexpected token `{}`", lit);
+
+        game._id = std::stoi(std::string{numstr});
+
+        auto samples = aoc::split(body, "; ");
+        for (const auto sample : samples) {
+            auto cubes = aoc::split(sample, ", ");
+            GameSet set{};
+
+            for (auto cube : cubes) {
+                auto [countstr, color] = aoc::split_once(cube, ' ').value();
+                auto count = std::stoi(std::string{countstr});
+                switch (Colors::find(color).value_or(Colors::size())) {
+                    case Colors::index("red"):
+                        set.red = count;
+                        break;
+                    case Colors::index("green"):
+                        set.green = count;
+                        break;
+                    case Colors::index("blue"):
+                        set.blue = count;
+                        break;
+                    default:
+                        aoc::panic(fmt::format("Unknown color `{}`", color));
+                }
+            }
+            game._sets.emplace_back(set.red, set.green, set.blue);
+        }
+
+        return game;
+    }
+
+    [[nodiscard]]
+    auto id() const {
+        return _id;
+    }
+
+    [[nodiscard]]
+    bool is_possible(const GameSet& max_set) const {
+        auto min_set = minimum_set();
+        return max_set.red >= min_set.red && max_set.green >= min_set.green
+            && max_set.blue >= min_set.blue;
+    }
+
+    [[nodiscard]]
+    uint64_t power() const {
+        auto min_set = minimum_set();
+
+        auto r = static_cast<uint64_t>(min_set.red);
+        auto g = static_cast<uint64_t>(min_set.green);
+        auto b = static_cast<uint64_t>(min_set.blue);
+        return r * g * b;
+    }
+
+private:
+    // fewest cubes of each color that make every sample possible, where each color
+    // is a separate scan over one column
+    [[nodiscard]]
+    GameSet minimum_set() const {
+        auto max_of = [](std::span<const int> counts) {
+            return counts.empty() ? 0 : std::ranges::max(counts);
+        };
+
+        return {
+            max_of(_sets.column<Colors::index("red")>()),
+            max_of(_sets.column<Colors::index("green")>()),
+            max_of(_sets.column<Colors::index("blue")>()),
+        };
+    }
+
+    int _id{};
+    aoc::SoA<int, int, int> _sets{};  // columns in `Colors` order
+};
+
+// games are independent, so both parts can also consume this directly while it parses
+inline aoc::Generator<Game> parse_games(std::filesystem::path path) {
+    for (const auto& line : aoc::read_lines(std::move(path))) {
+        co_yield Game::parse(line);
+    }
+}
+
+inline std::vector<Game> parse(const std::filesystem::path& path) {
+    return aoc::collect(parse_games(path));
+}
+
+// sum of the ids of games possible with 12 red, 13 green and 14 blue cubes
+template<std::ranges::input_range R>
+int sum_possible(R&& games) {
+    int sum{};
+    for (const auto& game : games) {
+        if (game.is_possible({12, 13, 14})) {
+            sum += game.id();
+        }
+    }
+    return sum;
+}
+
+template<std::ranges::input_range R>
+uint64_t sum_powers(R&& games) {
+    uint64_t sum{};
+    for (const auto& game : games) {
+        sum += game.power();
+    }
+    return sum;
+}
+
+inline int part1(const std::vector<Game>& games) {
+    return sum_possible(games);
+}
+
+inline uint64_t part2(const std::vector<Game>& games) {
+    return sum_powers(games);
+}
+
+// both parts in one pass, with reading, parsing and summing on separate threads
+inline std::pair<int, uint64_t> solve_pipelined(const std::filesystem::path& path) {
+    std::pair<int, uint64_t> result{};
+    aoc::run_pipeline(path, Game::parse, [&result](std::vector<Game>& games) {
+        result.first += sum_possible(games);
+        result.second += sum_powers(games);
+    });
+    return result;
+}
+
+}  // namespace day2
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "aoc/aoc.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <map>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace day4 {
+
+// Numbers are kept as strings in containers from a `std::pmr::memory_resource`, so a whole
+// input of cards can live in one `aoc::Arena`.
+class Card {
+public:
+    explicit Card(std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : _winning{mr},
+          _numbers{mr} {}
+
+    static Card parse(
+        const std::string& line,
+        std::pmr::memory_resource* mr = std::pmr::get_default_resource()
+    ) {
+        auto sv_to_int = [](std::string_view sv) {
+            std::string s{sv};
+            return std::stoi(s);
+        };
+
+        Card card{mr};
+        const auto [prefix, numbers] = aoc::split_once(line, ": ").value();
+        const auto [lit, id] = aoc::split_once(prefix, ' ').value();
+        card._id = sv_to_int(aoc::trim(id));
+
+        auto [winningstr, numstr] = aoc::split_once(numbers, " | ").value();
+        for (auto number : aoc::split(
+                 winningstr,
+                 ' ',
+                 aoc::SplitOptions::Trim | aoc::SplitOptions::DiscardEmpty
+             )) {
+            card._winning.emplace(number);
+        }
+
+        for (auto number :
+             aoc::split(numstr, ' ', aoc::SplitOptions::Trim | aoc::SplitOptions::DiscardEmpty)) {
+            card._numbers.emplace_back(number);
+        }
+
+        return card;
+    }
+
+    [[nodiscard]]
+    int id() const {
+        return _id;
+    }
+
+    [[nodiscard]]
+    int matches() const {
+        int count{};
+        for (const auto& num : _numbers) {
+            if (_winning.contains(num)) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    [[nodiscard]]
+    size_t points() const {
+        auto count = static_cast<size_t>(matches());
+        if (count <= 0) {
+            return 0;
+        }
+
+        return 1ULL << (count - 1);
+    }
+
+private:
+    int _id{};
+    std::pmr::unordered_set<std::pmr::string> _winning;
+    std::pmr::vector<std::pmr::string> _numbers;
+};
+
+// card points are independent, so part 1 can also consume this directly while it parses
+inline aoc::Generator<Card> parse_cards(
+    std::filesystem::path path,
+    std::pmr::memory_resource* mr = std::pmr::get_default_resource()
+) {
+    for (const auto& line : aoc::read_lines(std::move(path))) {
+        co_yield Card::parse(line, mr);
+    }
+}
+
+// the cards and everything they hold are allocated from `mr`
+inline std::pmr::vector<Card> parse(
+    const std::filesystem::path& path,
+    std::pmr::memory_resource* mr = std::pmr::get_default_resource()
+) {
+    std::pmr::vector<Card> cards{mr};
+    for (auto& card : parse_cards(path, mr)) {
+        cards.push_back(std::move(card));
+    }
+    return cards;
+}
+
+template<std::ranges::input_range R>
+size_t sum_points(R&& cards) {
+    size_t sum{};
+    for (const auto& card : cards) {
+        sum += card.points();
+    }
+    return sum;
+}
+
+inline size_t part1(std::span<const Card> cards) {
+    return sum_points(cards);
+}
+
+inline int part2(std::span<const Card> cards) {
+    std::map<int, int> counts{};
+
+    auto inc_count = [&counts](int id, int amount = 1) {
+        if (!counts.contains(id)) {
+            counts[id] = amount;
+        } else {
+            counts[id] += amount;
+        }
+    };
+
+    for (const auto& card : cards) {
+        // this is the "original" card, so we need to track it in the map.
+        // no matter what, the count always increments by 1 since this is
+        // the first time we're seeing it
+        auto id = card.id();
+        inc_count(id);
+
+        auto start = card.id() + 1;
+        auto last = start + static_cast<int>(card.matches());
+        auto copies = counts[id];
+
+        // generate sequential copies for each copy of the current card
+        for (auto i : std::views::iota(start, last)) {
+            inc_count(i, copies);
+        }
+    }
+
+    int sum{};
+    for (const auto& [_, count] : counts) {
+        sum += count;
+    }
+    return sum;
+}
+
+// both parts in one pass, with reading, parsing and scoring on separate threads
+inline std::pair<size_t, int> solve_pipelined(const std::filesystem::path& path) {
+    size_t points{};
+    std::vector<Card> cards{};
+    auto parse_card = [](const std::string& line) { return Card::parse(line); };
+    aoc::run_pipeline(path, parse_card, [&points, &cards](std::vector<Card>& batch) {
+        points += sum_points(batch);
+        std::ranges::move(batch, std::back_inserter(cards));
+    });
+
+    // cards win copies of the ones after them, so part 2 needs them back in order
+    std::ranges::sort(cards, {}, &Card::id);
+    return {points, part2(cards)};
+}
+
+}  // namespace day4
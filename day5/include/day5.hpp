@@ -2,12 +2,14 @@
 
 #include "aoc/aoc.hpp"
 
+#include <array>
 #include <filesystem>
-#include <list>
+#include <limits>
 #include <ranges>
 #include <set>
-#include <unordered_map>
+#include <span>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace day5 {
@@ -58,14 +60,14 @@ struct Range {
 
     [[nodiscard]]
     T offset(T value) const {
-        AOC_ASSERT(contains(value), "Range does not contain value");
+        AOC_DEBUG_ASSERT(contains(value), "Range does not contain value");
         auto off = value - src;
         return dst + off;
     }
 
     [[nodiscard]]
     T roffset(T value) const {
-        AOC_ASSERT(rcontains(value), "Range does not contain value");
+        AOC_DEBUG_ASSERT(rcontains(value), "Range does not contain value");
         auto off = value - dst;
         return src + off;
     }
@@ -73,24 +75,29 @@ struct Range {
 
 template<std::integral T>
 struct RangeMap {
-    std::vector<Range<T>> inner{};
+    // column indices of `inner`, matching the field order of `Range`
+    enum Field {
+        Src,
+        Dst,
+        Length,
+    };
+
+    aoc::SoA<T, T, T> inner{};
 
     [[nodiscard]]
     bool contains(const T& value) const {
-        return std::ranges::any_of(inner, [value](auto r) { return r.contains(value); });
+        return any_in_range(inner.template column<Src>(), value);
     }
 
     [[nodiscard]]
     bool rcontains(const T& value) const {
-        return std::ranges::any_of(inner, [value](auto r) { return r.rcontains(value); });
+        return any_in_range(inner.template column<Dst>(), value);
     }
 
     [[nodiscard]]
     T at(const T& value) const {
-        for (const auto& range : inner) {
-            if (range.contains(value)) {
-                return range.offset(value);
-            }
+        if (auto i = find_in_range(inner.template column<Src>(), value)) {
+            return range(*i).offset(value);
         }
 
         return value;
@@ -98,38 +105,82 @@ struct RangeMap {
 
     [[nodiscard]]
     T rev_at(const T& value) const {
-        for (const auto& range : inner) {
-            if (range.rcontains(value)) {
-                return range.roffset(value);
-            }
+        if (auto i = find_in_range(inner.template column<Dst>(), value)) {
+            return range(*i).roffset(value);
         }
 
         return value;
     }
 
+    [[nodiscard]]
+    Range<T> range(size_t i) const {
+        auto [src, dst, length] = inner[i];
+        return {src, dst, length};
+    }
+
     void add(const Range<T>& other) {
-        inner.push_back(other);
+        inner.emplace_back(other.src, other.dst, other.length);
+    }
+
+private:
+    // branchless so the scan over both columns can be vectorized
+    [[nodiscard]]
+    bool any_in_range(std::span<const T> starts, T value) const {
+        auto lengths = inner.template column<Length>();
+        bool found{};
+        for (size_t i = 0; i < starts.size(); ++i) {
+            found |= (value >= starts[i]) & (value < starts[i] + lengths[i]);
+        }
+        return found;
+    }
+
+    [[nodiscard]]
+    std::optional<size_t> find_in_range(std::span<const T> starts, T value) const {
+        auto lengths = inner.template column<Length>();
+        for (size_t i = 0; i < starts.size(); ++i) {
+            if (value >= starts[i] && value < starts[i] + lengths[i]) {
+                return i;
+            }
+        }
+        return {};
     }
 };
 
 template<std::integral T>
-std::unordered_set<Seed<T>> gen_seed_range(std::vector<T>& nums) {
+std::unordered_set<Seed<T>> gen_seed_range(const std::vector<T>& nums) {
     std::unordered_set<Seed<T>> result{};
-    for (size_t i = 0, j = 1; j < nums.size(); i += 2, j += 2) {
-        auto s = Seed{nums.at(i), nums.at(j)};
-        spdlog::debug("Generate seed range: start={}, length={}", s.value, s.length);
+    for (const auto pair : aoc::chunk(nums, 2)) {
+        if (pair.size() < 2) {
+            break;
+        }
+        auto s = Seed{pair[0], pair[1]};
+        AOC_DEBUG("Generate seed range: start={}, length={}", s.value, s.length);
         result.insert(s);
     }
     return result;
 }
 
+// map names in the order they are applied, from seed to location
+using MapNames = aoc::static_map<
+    "seed-to-soil",
+    "soil-to-fertilizer",
+    "fertilizer-to-water",
+    "water-to-light",
+    "light-to-temperature",
+    "temperature-to-humidity",
+    "humidity-to-location">;
+
+// Parsed once and only read afterwards, so both parts can share it. The seeds line is kept
+// as two views: single seeds for part 1 and (start, length) ranges for part 2.
 class Almanac {
 public:
-    static Almanac parse(const std::filesystem::path& path, bool use_seed_ranges = false) {
+    using Seeds = std::unordered_set<Seed<size_t>>;
+
+    static Almanac parse(const std::filesystem::path& path) {
         auto input = aoc::open(path);
 
         Almanac almanac{};
-        std::string curr_map{};
+        size_t curr_map{};
 
         std::string line{};
         while (std::getline(input, line)) {
@@ -139,7 +190,7 @@ public:
 
             // parse seeds
             if (line.starts_with("seeds:")) {
-                spdlog::info("Parsing seed numbers");
+                AOC_INFO("Parsing seed numbers");
                 auto [_, values] = aoc::split_once(line, ": ").value();
                 auto seedstr = aoc::
                     split(values, ' ', aoc::SplitOptions::Trim | aoc::SplitOptions::DiscardEmpty);
@@ -151,26 +202,16 @@ public:
                     [](auto s) { return std::stoull(std::string{s}); }
                 );
 
-                if (use_seed_ranges) {
-                    almanac._seeds = gen_seed_range(nums);
-                } else {
-                    std::transform(
-                        nums.begin(),
-                        nums.end(),
-                        std::inserter(almanac._seeds, almanac._seeds.end()),
-                        [](auto s) {
-                            return Seed{s, 1ULL};
-                        }
-                    );
-                }
+                almanac.set_numbers(std::move(nums));
 
                 continue;
             }
 
             // parse map section
             if (line.ends_with(':')) {
-                curr_map = aoc::split(line, ' ')[0];
-                spdlog::info("Parsed map name: `{}`", curr_map);
+                auto name = aoc::split(line, ' ')[0];
+                curr_map = MapNames::index(name);
+                AOC_INFO("Parsed map name: `{}`", name);
                 continue;
             }
 
@@ -182,8 +223,9 @@ public:
             });
             AOC_ASSERT(nums.size() == 3, "Mapping should have exactly 3 numbers");
             Range<size_t> range{nums[1], nums[0], nums[2]};
-            spdlog::
-                trace("Adding range src={}, dst={}, count={}", range.src, range.dst, range.length);
+            AOC_TRACE(
+                "Adding range src={}, dst={}, count={}", range.src, range.dst, range.length
+            );
             almanac._maps[curr_map].add(range);
         }
 
@@ -191,75 +233,114 @@ public:
     }
 
     [[nodiscard]]
-    std::list<size_t> map_location(size_t seed) const {
-        std::list<size_t> mapping{};
-        mapping.push_back(seed);
-        for (const auto& name : _keys) {
-            const auto& map = _maps.at(name);
-            size_t val = mapping.back();
-            if (map.contains(val)) {
-                val = map.at(val);
-            }
-            mapping.push_back(val);
+    std::array<size_t, MapNames::size() + 1> map_location(size_t seed) const {
+        std::array<size_t, MapNames::size() + 1> mapping{};
+        mapping[0] = seed;
+        for (size_t i = 0; i < _maps.size(); ++i) {
+            mapping[i + 1] = _maps[i].at(mapping[i]);
         }
-
-        AOC_ASSERT(mapping.size() == 8, "Mapping should have exactly 8 elements");
         return mapping;
     }
 
+    // seed that ends up at `loc`, if it is one of `seeds`
     [[nodiscard]]
-    std::optional<size_t> find_seed(size_t loc) {
+    std::optional<size_t> find_seed(size_t loc, const Seeds& seeds) const {
         size_t value = loc;
-        for (const auto& name : std::views::reverse(_keys)) {
-            const auto& map = _maps.at(name);
-            if (map.rcontains(value)) {
-                value = map.rev_at(value);
-            }
+        for (const auto& map : std::views::reverse(_maps)) {
+            value = map.rev_at(value);
         }
 
-        if (std::ranges::any_of(_seeds, [value](auto r) { return r.contains(value); })) {
+        if (std::ranges::any_of(seeds, [value](auto r) { return r.contains(value); })) {
             return value;
         }
         return {};
     }
 
     [[nodiscard]]
-    const std::unordered_set<Seed<size_t>>& seeds() const {
+    std::optional<size_t> find_seed(size_t loc) const {
+        return find_seed(loc, _seeds);
+    }
+
+    // every number on the seeds line as a seed of its own
+    [[nodiscard]]
+    const Seeds& seeds() const {
         return _seeds;
     }
 
+    // the seeds line read as (start, length) pairs
+    [[nodiscard]]
+    const Seeds& seed_ranges() const {
+        return _seed_ranges;
+    }
+
     void set_seeds(const std::set<size_t>& seeds) {
-        _seeds.clear();
-        std::
-            transform(seeds.begin(), seeds.end(), std::inserter(_seeds, _seeds.end()), [](auto s) {
-                return Seed{s, 1ULL};
-            });
+        set_numbers({seeds.begin(), seeds.end()});
     }
 
-    RangeMap<size_t>& operator[](const std::string& key) {
-        return _maps[key];
+    RangeMap<size_t>& operator[](std::string_view key) {
+        return _maps.at(MapNames::index(key));
     }
 
 private:
-    std::unordered_set<Seed<size_t>> _seeds{};
-    std::vector<std::string> _keys{
-        "seed-to-soil",
-        "soil-to-fertilizer",
-        "fertilizer-to-water",
-        "water-to-light",
-        "light-to-temperature",
-        "temperature-to-humidity",
-        "humidity-to-location",
-    };
-    std::unordered_map<std::string, RangeMap<size_t>> _maps{
-        {"seed-to-soil", {}},
-        {"soil-to-fertilizer", {}},
-        {"fertilizer-to-water", {}},
-        {"water-to-light", {}},
-        {"light-to-temperature", {}},
-        {"temperature-to-humidity", {}},
-        {"humidity-to-location", {}},
-    };
+    void set_numbers(std::vector<size_t> numbers) {
+        _numbers = std::move(numbers);
+        _seeds.clear();
+        std::transform(
+            _numbers.begin(),
+            _numbers.end(),
+            std::inserter(_seeds, _seeds.end()),
+            [](auto s) {
+                return Seed{s, 1ULL};
+            }
+        );
+        _seed_ranges = gen_seed_range(_numbers);
+    }
+
+    std::vector<size_t> _numbers{};
+    Seeds _seeds{};
+    Seeds _seed_ranges{};
+    std::array<RangeMap<size_t>, MapNames::size()> _maps{};
 };
 
+inline Almanac parse(const std::filesystem::path& path) {
+    return Almanac::parse(path);
+}
+
+inline size_t part1(const Almanac& almanac) {
+    size_t result{std::numeric_limits<size_t>::max()};
+    for (auto seed : almanac.seeds()) {
+        auto s = seed.value;
+        auto loc = almanac.map_location(s);
+        AOC_TRACE("seed={}, loc={}, map=[ {} ]", s, loc.back(), fmt::join(loc, " -> "));
+        result = std::min(result, loc.back());
+    }
+    return result;
+}
+
+inline size_t part2(const Almanac& almanac) {
+    const auto& ranges = almanac.seed_ranges();
+
+    // Locations are searched in blocks spread over the thread pool. Each block reports its
+    // lowest hit, so the first block with any hit holds the answer.
+    constexpr size_t BLOCK{1 << 20};
+    constexpr auto NONE = std::numeric_limits<size_t>::max();
+
+    AOC_INFO("Searching for lowest location with seed");
+    for (size_t base = 0;; base += BLOCK) {
+        auto loc = aoc::parallel_reduce(
+            base,
+            base + BLOCK,
+            NONE,
+            [&almanac, &ranges](size_t loc) {
+                return almanac.find_seed(loc, ranges).has_value() ? loc : NONE;
+            },
+            [](size_t a, size_t b) { return std::min(a, b); }
+        );
+        if (loc != NONE) {
+            return loc;
+        }
+        AOC_DEBUG("No valid locations, idx={}", base + BLOCK);
+    }
+}
+
 }  // namespace day5
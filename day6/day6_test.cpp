@@ -42,3 +42,22 @@ TEST(Day6, ExampleWinConditions) {
 
     EXPECT_EQ(day6::margin_of_error(races), 288);
 }
+
+TEST(Day6, CountWins) {
+    static_assert(day6::count_wins(7, 9) == 4);
+    static_assert(day6::count_wins(30, 200) == 9);
+
+    EXPECT_EQ(day6::count_wins(15, 40), 8);
+    EXPECT_EQ(day6::count_wins(71530, 940200), 71503);
+    EXPECT_EQ(day6::count_wins(4, 4), 0);
+}
+
+TEST(Day6, SolveConstexpr) {
+    constexpr std::string_view example{"Time:      7  15   30\nDistance:  9  40  200\n"};
+    static_assert(day6::solve_constexpr(example) == std::pair<int64_t, int64_t>{288, 71503});
+    constexpr std::string_view crlf{"Time:      7  15   30\r\nDistance:  9  40  200\r\n"};
+    static_assert(day6::solve_constexpr(crlf) == day6::solve_constexpr(example));
+
+    day6::RaceData data{"      7  15   30", "  9  40  200"};
+    EXPECT_EQ(day6::solve_constexpr(example), std::pair(day6::part1(data), day6::part2(data)));
+}
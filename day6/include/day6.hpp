@@ -2,6 +2,12 @@
 
 #include "aoc/aoc.hpp"
 
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 namespace day6 {
 
 class Race {
@@ -96,4 +102,120 @@ inline int64_t margin_of_error(const std::vector<Race>& races) {
     return ways;
 }
 
+// both lines are kept as text, since part 2 reads them as a single number
+struct RaceData {
+    std::string time{};
+    std::string distance{};
+};
+
+inline RaceData parse(const std::filesystem::path& path) {
+    auto input = aoc::open(path);
+
+    RaceData result{};
+    std::string line{};
+    while (std::getline(input, line)) {
+        AOC_ASSERT(line.find(':') != std::string::npos, "Line does not contain required `:`");
+        auto [prefix, body] = aoc::split_once(line, ':').value();
+
+        if (prefix == "Time") {
+            result.time = body;
+        } else if (prefix == "Distance") {
+            result.distance = body;
+        } else {
+            aoc::panic(fmt::format("Unknown prefix `{}`", prefix));
+        }
+    }
+    return result;
+}
+
+inline int64_t part1(const RaceData& data) {
+    using num_t = Race::num_t;
+
+    auto split_to_nums = [](const std::string& s) {
+        auto strs = aoc::split(s, ' ', aoc::SplitOptions::DiscardEmpty | aoc::SplitOptions::Trim);
+        std::vector<num_t> nums{};
+        std::ranges::transform(strs, std::back_inserter(nums), [](auto s) {
+            return std::stod(std::string{s});
+        });
+        return nums;
+    };
+
+    auto times = split_to_nums(data.time);
+    auto distances = split_to_nums(data.distance);
+    AOC_ASSERT(times.size() == distances.size(), "Must have equal times and distances");
+
+    std::vector<Race> races{};
+    for (auto&& [time, distance] : aoc::zip(times, distances)) {
+        races.emplace_back(time, distance);
+    }
+
+    return margin_of_error(races);
+}
+
+inline int64_t part2(const RaceData& data) {
+    auto to_num = [](const std::string& s) {
+        auto copy = aoc::remove(s, ' ');
+        return stod(copy);
+    };
+
+    Race race{to_num(data.time), to_num(data.distance)};
+    return race.margin();
+}
+
+// Ways to beat `distance`, like `Race::margin` but in integers, so it can run at compile time
+// where `std::sqrt` cannot. The distance `v * (time - v)` is symmetric around `time / 2`, so
+// the winning charge times are `[v_min, time - v_min]`, and `v_min` is found by bisection.
+constexpr int64_t count_wins(int64_t time, int64_t distance) {
+    auto wins = [=](int64_t v) { return v * (time - v) > distance; };
+    int64_t lo{0};
+    int64_t hi{time / 2};
+    if (!wins(hi)) {
+        return 0;
+    }
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        if (wins(mid)) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return time - (2 * lo) + 1;
+}
+
+// Both parts from the input text, counting the wins of each race with `count_wins`.
+constexpr std::pair<int64_t, int64_t> solve_constexpr(std::string_view input) {
+    std::vector<int64_t> times{};
+    std::vector<int64_t> distances{};
+    // part 2 reads each line as one number, ignoring the spaces
+    int64_t time{};
+    int64_t distance{};
+
+    auto opts = aoc::SplitOptions::DiscardEmpty | aoc::SplitOptions::Trim;
+    for (auto line : aoc::split(input, '\n', opts)) {
+        auto fields = aoc::split_once(line, ':');
+        AOC_ASSERT(fields.has_value(), "Line does not contain required `:`");
+        auto [prefix, body] = *fields;
+        AOC_ASSERT(prefix == "Time" || prefix == "Distance", "Unknown line prefix");
+        auto& values = prefix == "Time" ? times : distances;
+        auto& joined = prefix == "Time" ? time : distance;
+
+        for (auto field : aoc::split(body, ' ', opts)) {
+            auto value = aoc::parse_int<int64_t>(field);
+            AOC_ASSERT(value.has_value(), "Race values must be numbers");
+            values.push_back(*value);
+            for (auto c : field) {
+                joined = (joined * 10) + (c - '0');
+            }
+        }
+    }
+    AOC_ASSERT(times.size() == distances.size(), "Must have equal times and distances");
+
+    int64_t ways{1};
+    for (size_t i = 0; i < times.size(); ++i) {
+        ways *= count_wins(times[i], distances[i]);
+    }
+    return {ways, count_wins(time, distance)};
+}
+
 }  // namespace day6
@@ -138,3 +138,67 @@ TEST(Day7, ExampleParse) {
         EXPECT_EQ(hand.bid(), bid) << "With line = `" << line << '`';
     }
 }
+
+TEST(Day7, ParsePlay) {
+    auto play = day7::parse_play("KTJJT 220\r");
+    EXPECT_EQ(play.cards, "KTJJT");
+    EXPECT_EQ(play.bid, 220);
+
+    // the same play makes a different hand under each rule set
+    EXPECT_EQ(Hand(play, {}).kind(), Hand::Kind::TwoPair);
+    EXPECT_EQ(Hand(play, day7::JOKERS_WILD).kind(), Hand::Kind::FourKind);
+    EXPECT_EQ(Hand(play, day7::JOKERS_WILD).bid(), 220);
+}
+
+TEST(Day7, ExampleWinnings) {
+    std::vector<day7::Play> plays{};
+    for (auto line : {"32T3K 765", "T55J5 684", "KK677 28", "KTJJT 220", "QQQJA 483"}) {
+        plays.push_back(day7::parse_play(line));
+    }
+
+    // hands come out lazily in input order, ranking sorts them
+    std::vector<size_t> bids{};
+    for (const auto& hand : day7::parse_hands(plays, {})) {
+        bids.push_back(hand.bid());
+    }
+    EXPECT_EQ(bids, (std::vector<size_t>{765, 684, 28, 220, 483}));
+
+    EXPECT_EQ(day7::part1(plays), 6440);
+    EXPECT_EQ(day7::part2(plays), 5905);
+}
+
+TEST(Day7, HandKey) {
+    const std::vector<std::string> hands{
+        "32T3K",
+        "T55J5",
+        "KK677",
+        "KTJJT",
+        "QQQJA",
+        "JJJJJ",
+        "AAAAJ",
+        "2345J",
+        "J2345",
+        "AAKKQ",
+    };
+
+    // the keys order hands like `Hand` does, with and without jokers
+    for (bool jokers : {false, true}) {
+        auto rules = jokers ? day7::JOKERS_WILD : day7::RuleSet{};
+        for (const auto& a : hands) {
+            for (const auto& b : hands) {
+                auto expected = Hand{a, rules} < Hand{b, rules};
+                EXPECT_EQ(day7::hand_key(a, jokers) < day7::hand_key(b, jokers), expected)
+                    << a << " < " << b << " with jokers=" << jokers;
+            }
+        }
+    }
+}
+
+TEST(Day7, SolveConstexpr) {
+    constexpr std::string_view example{"32T3K 765\nT55J5 684\nKK677 28\nKTJJT 220\nQQQJA 483\n"};
+    static_assert(day7::solve_constexpr(example) == std::pair<size_t, size_t>{6440, 5905});
+    constexpr std::string_view crlf{
+        "32T3K 765\r\nT55J5 684\r\nKK677 28\r\nKTJJT 220\r\nQQQJA 483\r\n"
+    };
+    static_assert(day7::solve_constexpr(crlf) == day7::solve_constexpr(example));
+}
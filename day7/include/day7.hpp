@@ -2,9 +2,15 @@
 
 #include "aoc/aoc.hpp"
 
+#include <filesystem>
+#include <array>
+#include <cstdint>
 #include <ostream>
+#include <span>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace day7 {
 
@@ -12,11 +18,11 @@ const std::string LABELS{"23456789TJQKA"};
 
 struct RuleSet {
     std::string labels{"23456789TJQKA"};
-    std::vector<char> wild{};
+    aoc::FlatSet<char> wild{};
 
     [[nodiscard]]
     bool is_wild(char c) const {
-        return std::ranges::find(wild, c) != wild.end();
+        return wild.contains(c);
     }
 
     [[nodiscard]]
@@ -54,7 +60,35 @@ struct Card {
     auto operator<=>(const Card&) const = default;
 };
 
+// One line of the input. The cards stay as labels, since their values and the hand's kind
+// depend on the rules, but both rule sets use the same labels, so they are checked here.
+struct Play {
+    std::string cards{};
+    size_t bid{};
+};
+
+inline Play parse_play(std::string_view line) {
+    auto fields = aoc::split_once(aoc::trim(line), ' ');
+    if (!fields.has_value()) {
+        aoc::panic(fmt::format("expected cards and a bid in `{}`", line));
+    }
+    auto [cards, bidstr] = *fields;
+    for (auto c : cards) {
+        if (LABELS.find(c) == std::string::npos) {
+            aoc::panic(fmt::format("unknown card `{}`", c));
+        }
+    }
+    auto bid = aoc::parse_int<size_t>(bidstr);
+    if (!bid.has_value()) {
+        aoc::panic(fmt::format("invalid bid `{}`", bidstr));
+    }
+    return Play{std::string{cards}, *bid};
+}
+
 class Hand {
+    // a hand never holds more than five cards, so scratch buffers can stay on the stack
+    using CardBuffer = aoc::SmallVector<Card, 5>;
+
 public:
     enum class Kind {
         HighCard,
@@ -72,15 +106,12 @@ public:
         _cards = Card::parse(s, _rules);
     }
 
-    static Hand parse(std::string_view s, RuleSet rules = {}) {
-        auto [cards, bid] = aoc::split_once(s, ' ').value();
-        Hand hand{};
-
-        hand._cards = Card::parse(cards, rules);
-        hand._bid = std::stoull(std::string{bid});
-        hand._rules = std::move(rules);
+    Hand(const Play& play, RuleSet rules) : Hand{play.cards, std::move(rules)} {
+        _bid = play.bid;
+    }
 
-        return hand;
+    static Hand parse(std::string_view s, RuleSet rules = {}) {
+        return Hand{parse_play(s), std::move(rules)};
     }
 
     [[nodiscard]]
@@ -175,7 +206,7 @@ public:
 
 private:
     [[nodiscard]]
-    static Kind kind_impl(const std::vector<Card>& cards) {
+    static Kind kind_impl(std::span<const Card> cards) {
         std::unordered_map<int, int> counts{};
         for (const auto& card : cards) {
             if (!counts.contains(card.value)) {
@@ -185,7 +216,7 @@ private:
             }
         }
 
-        std::vector<int> values{};
+        aoc::SmallVector<int, 5> values{};
         values.reserve(counts.size());
         for (const auto& [_, count] : counts) {
             values.push_back(count);
@@ -222,9 +253,9 @@ private:
         aoc::panic("Unknown hand kind");
     }
 
-    static std::vector<std::vector<Card>> wild_combinations(
-        const std::vector<Card>& cards,
-        const std::vector<Card>& choices,
+    static std::vector<CardBuffer> wild_combinations(
+        std::span<const Card> cards,
+        std::span<const Card> choices,
         size_t count
     ) {
         // combination logic from: https://stackoverflow.com/a/39680841
@@ -233,7 +264,7 @@ private:
         //   total combinations = base^length
 
         if (count <= 0) {
-            return {cards};
+            return {CardBuffer{cards.begin(), cards.end()}};
         }
 
         size_t base = choices.size();
@@ -243,19 +274,20 @@ private:
             total *= base;
         }
 
-        std::vector<std::vector<Card>> result{};
+        std::vector<CardBuffer> result{};
+        result.reserve(total);
         for (size_t i = 0; i < total; i++) {
-            std::vector<Card> c{cards.begin(), cards.end()};
+            CardBuffer c{cards.begin(), cards.end()};
 
             for (auto n = i; n > 0;) {
                 auto d = n % base;
-                c.push_back(choices.at(d));
+                c.push_back(choices[d]);
                 n /= base;
             }
             while (c.size() < length) {
-                c.push_back(choices.at(0));
+                c.push_back(choices.front());
             }
-            result.push_back(c);
+            result.push_back(std::move(c));
         }
 
         return result;
@@ -277,8 +309,8 @@ private:
         }
 
         size_t wilds{};
-        std::vector<Card> cards{};
-        std::vector<Card> choices{};
+        CardBuffer cards{};
+        CardBuffer choices{};
         for (const auto& c : _cards) {
             if (!_rules.is_wild(c.value)) {
                 cards.push_back(c);
@@ -343,4 +375,148 @@ inline std::ostream& operator<<(std::ostream& os, const Hand& hand) {
     return os << hand.to_string();
 }
 
+// hand strength depends on the rules, so both parts share the plays and value the cards
+// under their own rules
+inline std::vector<Play> parse(const std::filesystem::path& path) {
+    auto input = aoc::open(path);
+
+    std::vector<Play> plays{};
+    std::string line{};
+    while (std::getline(input, line)) {
+        plays.push_back(parse_play(line));
+    }
+    return plays;
+}
+
+// `plays` must outlive the generator, which only builds a hand when it is pulled
+inline aoc::Generator<Hand> parse_hands(std::span<const Play> plays, RuleSet rules) {
+    for (const auto& play : plays) {
+        co_yield Hand{play, rules};
+    }
+}
+
+// winnings depend on each hand's rank among all of them, so they are collected and sorted
+inline std::vector<Hand> ranked_hands(std::span<const Play> plays, const RuleSet& rules) {
+    auto hands = aoc::collect(parse_hands(plays, rules));
+    std::ranges::sort(hands);
+    return hands;
+}
+
+inline size_t winnings(const std::vector<Hand>& hands) {
+    size_t result{};
+    for (const auto [i, hand] : aoc::enumerate(hands)) {
+        auto rank = i + 1;
+        result += hand.bid() * rank;
+    }
+    return result;
+}
+
+inline size_t part1(const std::vector<Play>& plays) {
+    return winnings(ranked_hands(plays, {}));
+}
+
+inline size_t part2(const std::vector<Play>& plays) {
+    return winnings(ranked_hands(plays, JOKERS_WILD));
+}
+
+// both parts in one pass: each line is parsed once and valued under both rule sets while the
+// file is still being read, then the hands are ranked
+inline std::pair<size_t, size_t> solve_pipelined(const std::filesystem::path& path) {
+    std::vector<Hand> plain{};
+    std::vector<Hand> jokers{};
+    aoc::run_pipeline(
+        path,
+        [](const std::string& line) {
+            auto play = parse_play(line);
+            return std::pair{Hand{play, {}}, Hand{play, JOKERS_WILD}};
+        },
+        [&plain, &jokers](std::vector<std::pair<Hand, Hand>>& batch) {
+            for (auto& [p, j] : batch) {
+                plain.push_back(std::move(p));
+                jokers.push_back(std::move(j));
+            }
+        }
+    );
+
+    std::ranges::sort(plain);
+    std::ranges::sort(jokers);
+    return {winnings(plain), winnings(jokers)};
+}
+
+// Orders hands like `Hand::operator<` for five cards, as one number: the kind above the card
+// values, which take four bits each. With `jokers`, `J` is wild and the weakest card, like in
+// `JOKERS_WILD`. Unlike `Hand`, it does not allocate, so it can run at compile time.
+constexpr uint32_t hand_key(std::string_view cards, bool jokers) {
+    constexpr std::string_view plain_labels{"23456789TJQKA"};
+    constexpr std::string_view joker_labels{"J23456789TQKA"};
+    auto labels = jokers ? joker_labels : plain_labels;
+    AOC_ASSERT(cards.size() == 5, "Hand must have five cards");
+
+    uint32_t key{};
+    std::array<int, 13> counts{};
+    int wilds{};
+    for (auto c : cards) {
+        auto value = labels.find(c);
+        AOC_ASSERT(value != std::string_view::npos, "Unknown card");
+        key = (key << 4) | static_cast<uint32_t>(value);
+        if (jokers && c == 'J') {
+            wilds++;
+        } else {
+            counts.at(value)++;
+        }
+    }
+
+    // the kind only depends on the two largest groups, and wild cards are always worth the
+    // most when they join the largest one
+    int first{};
+    int second{};
+    for (auto n : counts) {
+        if (n > first) {
+            second = first;
+            first = n;
+        } else if (n > second) {
+            second = n;
+        }
+    }
+    first += wilds;
+
+    auto kind = Hand::Kind::HighCard;
+    if (first == 5) {
+        kind = Hand::Kind::FiveKind;
+    } else if (first == 4) {
+        kind = Hand::Kind::FourKind;
+    } else if (first == 3) {
+        kind = second == 2 ? Hand::Kind::FullHouse : Hand::Kind::ThreeKind;
+    } else if (first == 2) {
+        kind = second == 2 ? Hand::Kind::TwoPair : Hand::Kind::OnePair;
+    }
+    return (static_cast<uint32_t>(kind) << 20) | key;
+}
+
+// Both parts from the input text, ranking each hand by its `hand_key` under both rules.
+constexpr std::pair<size_t, size_t> solve_constexpr(std::string_view input) {
+    std::vector<std::pair<uint32_t, size_t>> plain{};
+    std::vector<std::pair<uint32_t, size_t>> jokers{};
+    auto opts = aoc::SplitOptions::DiscardEmpty | aoc::SplitOptions::Trim;
+    for (auto line : aoc::split(input, '\n', opts)) {
+        auto fields = aoc::split_once(line, ' ');
+        AOC_ASSERT(fields.has_value(), "Line must have cards and a bid");
+        auto [cards, bidstr] = *fields;
+        auto bid = aoc::parse_int<size_t>(bidstr);
+        AOC_ASSERT(bid.has_value(), "Bid must be a number");
+        plain.emplace_back(hand_key(cards, false), *bid);
+        jokers.emplace_back(hand_key(cards, true), *bid);
+    }
+
+    auto winnings = [](auto& hands) {
+        std::ranges::sort(hands);
+        size_t result{};
+        for (size_t i = 0; i < hands.size(); ++i) {
+            result += hands[i].second * (i + 1);
+        }
+        return result;
+    };
+    return {winnings(plain), winnings(jokers)};
+}
+
 }  // namespace day7
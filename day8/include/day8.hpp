@@ -1,5 +1,7 @@
 #pragma once
 
+#include <filesystem>
+#include <memory_resource>
 #include <numeric>
 #include "aoc/aoc.hpp"
 
@@ -27,38 +29,60 @@ struct Direction {
     }
 };
 
+// Node names are stored in containers from a `std::pmr::memory_resource`, so a whole
+// network can live in one `aoc::Arena`.
 class Network {
-    using Key = std::string;
-    using Value = std::pair<std::string, std::string>;
+    using Key = std::pmr::string;
+    using Value = std::pair<std::pmr::string, std::pmr::string>;
+
+    // let `std::string` and `std::string_view` look up `Key`s without a conversion
+    struct KeyHash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view s) const {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    struct KeyEqual {
+        using is_transparent = void;
+
+        bool operator()(std::string_view a, std::string_view b) const {
+            return a == b;
+        }
+    };
 
 public:
+    explicit Network(std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : _map{mr} {}
+
     void add(const Direction& direction) {
-        _map[direction.name] = {direction.left, direction.right};
+        add(direction.name, direction.left, direction.right);
     }
 
     void add(std::string_view direction) {
-        auto dir = Direction::parse(direction);
-        _map[dir.name] = {dir.left, dir.right};
+        add(Direction::parse(direction));
     }
 
     size_t steps(
         std::string_view directions,
         const std::string& from = "AAA",
         const std::string& to = "ZZZ"
-    ) {
+    ) const {
         AOC_ASSERT(
             _map.contains(from) && _map.contains(to),
             "Map must contain start and end destinations"
         );
 
-        std::string current{from};
+        // views the stored names instead of copying them
+        std::string_view current{from};
         size_t count{};
 
         size_t idx{};
         while (current != to) {
             count++;
             auto c = directions.at(idx);
-            const auto& [left, right] = _map[current];
+            const auto& [left, right] = next(current);
             current = c == 'L' ? left : right;
             idx = (idx + 1) % directions.length();
         }
@@ -70,41 +94,35 @@ public:
         std::string_view directions,
         const std::string& from_suffix = "A",
         const std::string& to_suffix = "Z"
-    ) {
+    ) const {
         AOC_ASSERT(
             !(from_suffix.empty() || to_suffix.empty()),
             "Map must contain start and end suffixes"
         );
 
-        std::vector<std::pair<std::string, size_t>> nodes{};
+        size_t count = 1;
         for (const auto& [node, _] : _map) {
             if (node.ends_with(from_suffix)) {
-                auto cycles = cycle_length(directions, node, to_suffix);
-                nodes.emplace_back(node, cycles);
+                count = std::lcm(count, cycle_length(directions, node, to_suffix));
             }
         }
 
-        size_t count = 1;
-        for (const auto& [_, cycles] : nodes) {
-            count = std::lcm(count, cycles);
-        }
-
         return count;
     }
 
     size_t cycle_length(
         std::string_view directions,
-        const std::string& start,
-        const std::string& end_suffix
-    ) {
+        std::string_view start,
+        std::string_view end_suffix
+    ) const {
         size_t count{};
         size_t idx{};
-        std::string current{start};
+        std::string_view current{start};
 
         while (!current.ends_with(end_suffix)) {
             count++;
             char c = directions.at(idx);
-            const auto& [left, right] = _map[current];
+            const auto& [left, right] = next(current);
             current = c == 'L' ? left : right;
             idx = (idx + 1) % directions.length();
         }
@@ -113,6 +131,54 @@ public:
     }
 
 private:
-    std::unordered_map<Key, Value> _map{};
+    void add(std::string_view name, std::string_view left, std::string_view right) {
+        auto* mr = _map.get_allocator().resource();
+        _map.insert_or_assign(Key{name, mr}, Value{Key{left, mr}, Key{right, mr}});
+    }
+
+    // `unordered_map::at` has no heterogeneous overload until C++26
+    [[nodiscard]]
+    const Value& next(std::string_view node) const {
+        auto it = _map.find(node);
+        AOC_ASSERTF(it != _map.end(), "Unknown node `{}`", node);
+        return it->second;
+    }
+
+    std::pmr::unordered_map<Key, Value, KeyHash, KeyEqual> _map;
+};
+
+struct Input {
+    Network network{};
+    std::string directions{};
 };
+
+// the network and its node names are allocated from `mr`
+inline Input parse(
+    const std::filesystem::path& path,
+    std::pmr::memory_resource* mr = std::pmr::get_default_resource()
+) {
+    auto input = aoc::open(path);
+    Input result{Network{mr}};
+    std::getline(input, result.directions);
+
+    std::string line{};
+    while (std::getline(input, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        result.network.add(line);
+    }
+
+    return result;
+}
+
+inline size_t part1(const Input& input) {
+    return input.network.steps(input.directions);
+}
+
+inline size_t part2(const Input& input) {
+    return input.network.steps_parallel(input.directions);
+}
+
 }  // namespace day8
@@ -1,43 +1,12 @@
 #include "day8.hpp"
 
-#include <filesystem>
-
-using day8::Network;
-
-std::pair<Network, std::string> parse_map(const std::filesystem::path& path) {
-    auto input = aoc::open(path);
-    std::string directions{};
-    std::getline(input, directions);
-
-    Network network{};
-    std::string line{};
-    while (std::getline(input, line)) {
-        if (line.empty()) {
-            continue;
-        }
-
-        network.add(line);
-    }
-
-    return {network, directions};
-}
-
-void part1(const std::filesystem::path& path) {
-    auto [network, directions] = parse_map(path);
-    auto steps = network.steps(directions);
-
-    fmt::println("Part 1: {}", steps);
-}
-
-void part2(const std::filesystem::path& path) {
-    auto [network, directions] = parse_map(path);
-    auto steps = network.steps_parallel(directions);
-
-    fmt::println("Part 2: {}", steps);
-}
-
 int main() {
-    std::filesystem::path path{"data/day8.txt"};
-    part1(path);
-    part2(path);
+    auto [p1, p2] = aoc::solve_concurrently(
+        [] { return aoc::timed("parse", [] { return day8::parse("data/day8.txt"); }); },
+        [](const auto& input) { return aoc::timed("part1", [&] { return day8::part1(input); }); },
+        [](const auto& input) { return aoc::timed("part2", [&] { return day8::part2(input); }); }
+    );
+
+    fmt::println("Part 1: {}", p1);
+    fmt::println("Part 2: {}", p2);
 }
@@ -49,3 +49,41 @@ TEST(Day9, ReadingPast) {
         EXPECT_EQ(r.analyze(Direction::Past), expected);
     }
 }
+
+TEST(Day9, SumExtrapolated) {
+    const std::vector<std::string> lines{
+        "0 3 6 9 12 15",
+        "1 3 6 10 15 21",
+        "10 13 16 21 30 45",
+    };
+
+    // a lazily parsed range gives the same sums as the parsed vector
+    auto lazy = [](const std::vector<std::string>& lines) {
+        return std::views::transform(lines, [](const auto& line) { return Reading::parse(line); });
+    };
+    std::vector<Reading> readings{};
+    for (auto r : lazy(lines)) {
+        readings.push_back(std::move(r));
+    }
+
+    EXPECT_EQ(day9::sum_extrapolated(lazy(lines), Direction::Future), 114);
+    EXPECT_EQ(day9::part1(readings), 114);
+    EXPECT_EQ(day9::sum_extrapolated(lazy(lines), Direction::Past), 2);
+    EXPECT_EQ(day9::part2(readings), 2);
+}
+
+TEST(Day9, SolveConstexpr) {
+    constexpr std::string_view example{"0 3 6 9 12 15\n1 3 6 10 15 21\n10 13 16 21 30 45\n"};
+    static_assert(day9::solve_constexpr(example) == std::pair<int64_t, int64_t>{114, 2});
+    constexpr std::string_view crlf{"0 3 6 9 12 15\r\n1 3 6 10 15 21\r\n10 13 16 21 30 45\r\n"};
+    static_assert(day9::solve_constexpr(crlf) == day9::solve_constexpr(example));
+
+    // matches `Reading::analyze`, also for negative values
+    for (std::string_view line : {"0 3 6 9 12 15", "-1 0 7 26 63 124", "5 5 5", "0 0"}) {
+        auto reading = Reading::parse(line);
+        std::vector<int64_t> values{reading.values().begin(), reading.values().end()};
+        for (auto dir : {Direction::Future, Direction::Past}) {
+            EXPECT_EQ(day9::extrapolate(values, dir), reading.analyze(dir)) << line;
+        }
+    }
+}
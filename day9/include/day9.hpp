@@ -3,6 +3,11 @@
 #include "aoc/aoc.hpp"
 
 #include <deque>
+#include <filesystem>
+#include <ranges>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace day9 {
 
@@ -71,4 +76,94 @@ private:
     std::deque<int64_t> _nums{};
 };
 
+// readings are independent, so both parts can also consume this directly while it parses
+inline aoc::Generator<Reading> parse_readings(std::filesystem::path path) {
+    for (const auto& line : aoc::read_lines(std::move(path))) {
+        co_yield Reading::parse(line);
+    }
+}
+
+inline std::vector<Reading> parse(const std::filesystem::path& path) {
+    return aoc::collect(parse_readings(path));
+}
+
+// sum of the values extrapolated from every reading
+template<std::ranges::input_range R>
+int64_t sum_extrapolated(R&& readings, Reading::Direction dir) {
+    int64_t sum{};
+    for (const auto& reading : readings) {
+        sum += reading.analyze(dir);
+    }
+    return sum;
+}
+
+inline int64_t part1(const std::vector<Reading>& readings) {
+    return sum_extrapolated(readings, Reading::Direction::Future);
+}
+
+inline int64_t part2(const std::vector<Reading>& readings) {
+    return sum_extrapolated(readings, Reading::Direction::Past);
+}
+
+// Same result as `Reading::analyze`, but it can run at compile time. Each row of differences
+// overwrites the one before it, and only its last (future) or first (past) value is needed:
+// the future value is the sum of the last values, the past one the alternating sum of the
+// first values.
+constexpr int64_t extrapolate(std::vector<int64_t> values, Reading::Direction dir) {
+    int64_t result{};
+    int64_t sign{1};
+    auto n = values.size();
+    auto zero = [](auto i) { return i == 0; };
+    while (!std::all_of(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(n), zero)) {
+        AOC_ASSERT(n > 1, "row does not contain any numbers");
+        result += dir == Reading::Direction::Future ? values[n - 1] : sign * values[0];
+        sign = -sign;
+        for (size_t i = 0; i + 1 < n; ++i) {
+            values[i] = values[i + 1] - values[i];
+        }
+        --n;
+    }
+    return result;
+}
+
+// Both parts from the input text, extrapolating each reading in both directions.
+constexpr std::pair<int64_t, int64_t> solve_constexpr(std::string_view input) {
+    std::pair<int64_t, int64_t> result{};
+    auto opts = aoc::SplitOptions::DiscardEmpty | aoc::SplitOptions::Trim;
+    for (auto line : aoc::split(input, '\n', opts)) {
+        std::vector<int64_t> values{};
+        for (auto field : aoc::split(line, ' ', aoc::SplitOptions::DiscardEmpty)) {
+            auto value = aoc::parse_int<int64_t>(field);
+            AOC_ASSERT(value.has_value(), "Readings must be numbers");
+            values.push_back(*value);
+        }
+        result.first += extrapolate(values, Reading::Direction::Future);
+        result.second += extrapolate(std::move(values), Reading::Direction::Past);
+    }
+    return result;
+}
+
+// Both parts in one pass. Extrapolating costs more than parsing, so it runs on the parser
+// threads as well, leaving only the sums to the reducer.
+inline std::pair<int64_t, int64_t> solve_pipelined(const std::filesystem::path& path) {
+    std::pair<int64_t, int64_t> result{};
+    aoc::run_pipeline(
+        path,
+        [](const std::string& line) {
+            auto reading = Reading::parse(line);
+            return std::pair{
+                reading.analyze(Reading::Direction::Future),
+                reading.analyze(Reading::Direction::Past),
+            };
+        },
+        [&result](std::vector<std::pair<int64_t, int64_t>>& values) {
+            for (auto [future, past] : values) {
+                result.first += future;
+                result.second += past;
+            }
+        }
+    );
+    return result;
+}
+
 }  // namespace day9
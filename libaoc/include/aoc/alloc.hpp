@@ -0,0 +1,36 @@
+#pragma once
+
+#include "aoc/types.hpp"
+
+namespace aoc {
+
+struct AllocStats {
+    u64 count{};
+    u64 bytes{};
+    // highest live heap size reached above the starting point, in bytes
+    u64 peak{};
+};
+
+// Opaque state saved at the start of a phase, see `alloc_begin`.
+struct AllocMark {
+    u64 count{};
+    u64 bytes{};
+    i64 live{};
+    i64 outer_peak{};
+};
+
+// True when libaoc was built with `AOC_TRACK_ALLOCS`, which replaces the global
+// `operator new`/`operator delete` with versions that count every allocation. Otherwise
+// all of the functions below report zeros.
+bool alloc_tracking_enabled();
+
+// Allocations are counted per thread, so a phase only sees the work of the thread it runs
+// on. Marks nest: a phase's peak includes any peaks reached inside phases nested in it, and
+// each `alloc_begin` must be matched by an `alloc_end` in reverse order.
+AllocMark alloc_begin();
+AllocStats alloc_end(const AllocMark& mark);
+
+// process-wide totals since startup, where `peak` is the highest live heap size
+AllocStats alloc_totals();
+
+}  // namespace aoc
@@ -2,10 +2,21 @@
 
 #include "aoc/types.hpp"  // IWYU pragma: export
 
+#include "aoc/alloc.hpp"  // IWYU pragma: export
+#include "aoc/arena.hpp"  // IWYU pragma: export
 #include "aoc/collections.hpp"  // IWYU pragma: export
 #include "aoc/core.hpp"  // IWYU pragma: export
 #include "aoc/digit.hpp"  // IWYU pragma: export
 #include "aoc/fs.hpp"  // IWYU pragma: export
+#include "aoc/generator.hpp"  // IWYU pragma: export
 #include "aoc/grid.hpp"  // IWYU pragma: export
 #include "aoc/hash.hpp"  // IWYU pragma: export
+#include "aoc/log.hpp"  // IWYU pragma: export
+#include "aoc/perf.hpp"  // IWYU pragma: export
+#include "aoc/pipeline.hpp"  // IWYU pragma: export
+#include "aoc/ring_buffer.hpp"  // IWYU pragma: export
+#include "aoc/static_map.hpp"  // IWYU pragma: export
+#include "aoc/stats.hpp"  // IWYU pragma: export
 #include "aoc/stringutils.hpp"  // IWYU pragma: export
+#include "aoc/task_graph.hpp"  // IWYU pragma: export
+#include "aoc/thread_pool.hpp"  // IWYU pragma: export
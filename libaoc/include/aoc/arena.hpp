@@ -0,0 +1,90 @@
+#pragma once
+
+#include "aoc/types.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace aoc {
+
+struct ArenaOptions {
+    // size of the first block, each following one doubles up to `MAX_BLOCK`
+    usize block_size{usize{64} << 10};
+    // back blocks with transparent huge pages where the OS offers them (Linux), blocks are
+    // then rounded up to whole 2 MiB pages. Silently falls back to regular pages elsewhere.
+    bool huge_pages{};
+};
+
+// Monotonic bump-pointer allocator, meant as the `std::pmr::memory_resource` of everything
+// parsed for one run, e.g.
+//
+//     aoc::Arena arena{};
+//     auto input = day8::parse(path, &arena);
+//
+// Allocating is a pointer increment within the current block, and deallocating does
+// nothing: memory only comes back all at once, through `reset` or the destructor. Records
+// allocated one after another therefore sit next to each other in memory. Not thread safe.
+class Arena : public std::pmr::memory_resource {
+public:
+    static constexpr usize MAX_BLOCK{usize{64} << 20};
+
+    explicit Arena(ArenaOptions opts = {});
+    Arena(const Arena&) = delete;
+    Arena(Arena&&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena& operator=(Arena&&) = delete;
+    ~Arena() override;
+
+    // Frees everything allocated so far. The memory is kept as a single block, so the next
+    // run of the same size does not allocate at all. Anything still pointing into the arena
+    // dangles.
+    void reset();
+
+    // bytes handed out since the last reset, including alignment padding
+    [[nodiscard]]
+    usize used() const {
+        return _used;
+    }
+
+    // bytes held in blocks, whether handed out or not
+    [[nodiscard]]
+    usize reserved() const;
+
+    [[nodiscard]]
+    usize blocks() const {
+        return _blocks.size();
+    }
+
+    // true if at least one block was mapped with the huge page hint
+    [[nodiscard]]
+    bool huge_pages() const;
+
+private:
+    struct Block {
+        std::byte* data{};
+        usize size{};
+        bool mapped{};
+    };
+
+    void* do_allocate(usize bytes, usize alignment) override;
+    void do_deallocate(void* /*ptr*/, usize /*bytes*/, usize /*alignment*/) override {}
+    [[nodiscard]]
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    void grow(usize min_size);
+    [[nodiscard]]
+    Block allocate_block(usize size) const;
+    static void free_block(const Block& block);
+
+    ArenaOptions _opts;
+    std::vector<Block> _blocks{};
+    std::byte* _cursor{};
+    std::byte* _end{};
+    usize _next_size{};
+    usize _used{};
+};
+
+}  // namespace aoc
@@ -1,7 +1,22 @@
 
 #pragma once
 
+#include "aoc/core.hpp"
+#include "aoc/types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -28,9 +43,870 @@ std::vector<std::pair<A, B>> zip_copy(const ContA& a, const ContB& b) {
     return result;
 }
 
+// uses the container's own lookup when it has one (sets, maps, `FlatSet`), otherwise a
+// linear search
 template<std::ranges::range Container, typename T = Container::value_type>
 bool contains(const Container& cont, const T& value) {
-    return std::ranges::find(cont, value) != std::end(cont);
+    if constexpr (requires { cont.contains(value); }) {
+        return cont.contains(value);
+    } else {
+        return std::ranges::find(cont, value) != std::end(cont);
+    }
+}
+
+namespace details {
+    template<typename IterA, typename IterB>
+    using zip_concept = std::conditional_t<
+        std::random_access_iterator<IterA> && std::random_access_iterator<IterB>,
+        std::random_access_iterator_tag,
+        std::conditional_t<
+            std::bidirectional_iterator<IterA> && std::bidirectional_iterator<IterB>,
+            std::bidirectional_iterator_tag,
+            std::forward_iterator_tag>>;
+
+    template<std::forward_iterator IterA, std::forward_iterator IterB>
+    class ZipIterator {
+        static constexpr bool bidirectional =
+            std::bidirectional_iterator<IterA> && std::bidirectional_iterator<IterB>;
+        static constexpr bool random_access =
+            std::random_access_iterator<IterA> && std::random_access_iterator<IterB>;
+
+    public:
+        using iterator_concept = zip_concept<IterA, IterB>;
+        using iterator_category = std::input_iterator_tag;  // dereferences to a proxy
+        using value_type = std::pair<std::iter_value_t<IterA>, std::iter_value_t<IterB>>;
+        using reference = std::pair<std::iter_reference_t<IterA>, std::iter_reference_t<IterB>>;
+        using difference_type =
+            std::common_type_t<std::iter_difference_t<IterA>, std::iter_difference_t<IterB>>;
+
+        ZipIterator() = default;
+
+        ZipIterator(IterA a, IterB b) : _a{std::move(a)}, _b{std::move(b)} {}
+
+        reference operator*() const {
+            return {*_a, *_b};
+        }
+
+        reference operator[](difference_type n) const
+            requires random_access
+        {
+            return *(*this + n);
+        }
+
+        ZipIterator& operator++() {
+            ++_a;
+            ++_b;
+            return *this;
+        }
+
+        ZipIterator operator++(int) {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        ZipIterator& operator--()
+            requires bidirectional
+        {
+            --_a;
+            --_b;
+            return *this;
+        }
+
+        ZipIterator operator--(int)
+            requires bidirectional
+        {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        ZipIterator& operator+=(difference_type n)
+            requires random_access
+        {
+            _a += static_cast<std::iter_difference_t<IterA>>(n);
+            _b += static_cast<std::iter_difference_t<IterB>>(n);
+            return *this;
+        }
+
+        ZipIterator& operator-=(difference_type n)
+            requires random_access
+        {
+            return *this += -n;
+        }
+
+        friend ZipIterator operator+(ZipIterator it, difference_type n)
+            requires random_access
+        {
+            return it += n;
+        }
+
+        friend ZipIterator operator+(difference_type n, ZipIterator it)
+            requires random_access
+        {
+            return it += n;
+        }
+
+        friend ZipIterator operator-(ZipIterator it, difference_type n)
+            requires random_access
+        {
+            return it -= n;
+        }
+
+        // both sides advance in lock step, so comparing the first iterator is enough
+        friend difference_type operator-(const ZipIterator& lhs, const ZipIterator& rhs)
+            requires random_access
+        {
+            return static_cast<difference_type>(lhs._a - rhs._a);
+        }
+
+        friend bool operator==(const ZipIterator& lhs, const ZipIterator& rhs) {
+            return lhs._a == rhs._a;
+        }
+
+        friend auto operator<=>(const ZipIterator& lhs, const ZipIterator& rhs)
+            requires random_access && std::three_way_comparable<IterA>
+        {
+            return lhs._a <=> rhs._a;
+        }
+
+        // the zip ends as soon as either side runs out
+        template<typename SentA, typename SentB>
+        [[nodiscard]]
+        bool reached(const SentA& end_a, const SentB& end_b) const {
+            return _a == end_a || _b == end_b;
+        }
+
+    private:
+        IterA _a{};
+        IterB _b{};
+    };
+
+    template<typename SentA, typename SentB>
+    struct ZipSentinel {
+        SentA a{};
+        SentB b{};
+
+        template<typename IterA, typename IterB>
+        friend bool operator==(const ZipIterator<IterA, IterB>& it, const ZipSentinel& end) {
+            return it.reached(end.a, end.b);
+        }
+    };
+
+    template<std::forward_iterator Iter, std::sentinel_for<Iter> Sent>
+    class ChunkIterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;  // dereferences to a prvalue
+        using value_type = std::ranges::subrange<Iter>;
+        using difference_type = std::iter_difference_t<Iter>;
+
+        ChunkIterator() = default;
+
+        ChunkIterator(Iter current, Sent end, difference_type n)
+            : _current{std::move(current)},
+              _end{std::move(end)},
+              _n{n} {}
+
+        value_type operator*() const {
+            return {_current, std::ranges::next(_current, _n, _end)};
+        }
+
+        ChunkIterator& operator++() {
+            _current = std::ranges::next(_current, _n, _end);
+            return *this;
+        }
+
+        ChunkIterator operator++(int) {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const ChunkIterator& lhs, const ChunkIterator& rhs) {
+            return lhs._current == rhs._current;
+        }
+
+        friend bool operator==(const ChunkIterator& it, std::default_sentinel_t) {
+            return it._current == it._end;
+        }
+
+    private:
+        Iter _current{};
+        Sent _end{};
+        difference_type _n{};
+    };
+}  // namespace details
+
+// Lazy, non-owning view over pairs of elements from two ranges, ending with the shorter
+// one. Iterators are random access (and the view is sized) when both ranges allow it.
+template<std::ranges::view A, std::ranges::view B>
+    requires std::ranges::forward_range<A> && std::ranges::forward_range<B>
+class ZipView : public std::ranges::view_interface<ZipView<A, B>> {
+public:
+    ZipView() = default;
+
+    ZipView(A a, B b) : _a{std::move(a)}, _b{std::move(b)} {}
+
+    auto begin() {
+        return make_begin(_a, _b);
+    }
+
+    auto begin() const
+        requires std::ranges::forward_range<const A> && std::ranges::forward_range<const B>
+    {
+        return make_begin(_a, _b);
+    }
+
+    auto end() {
+        return make_end(_a, _b);
+    }
+
+    auto end() const
+        requires std::ranges::forward_range<const A> && std::ranges::forward_range<const B>
+    {
+        return make_end(_a, _b);
+    }
+
+    auto size() const
+        requires std::ranges::sized_range<const A> && std::ranges::sized_range<const B>
+    {
+        using size_type = std::common_type_t<
+            std::ranges::range_size_t<const A>,
+            std::ranges::range_size_t<const B>>;
+        return std::min<size_type>(std::ranges::size(_a), std::ranges::size(_b));
+    }
+
+private:
+    template<typename RA, typename RB>
+    static auto make_begin(RA& a, RB& b) {
+        using Iter = details::
+            ZipIterator<std::ranges::iterator_t<RA>, std::ranges::iterator_t<RB>>;
+        return Iter{std::ranges::begin(a), std::ranges::begin(b)};
+    }
+
+    // a common range when the end can be computed, otherwise a sentinel for either end
+    template<typename RA, typename RB>
+    static auto make_end(RA& a, RB& b) {
+        if constexpr (std::ranges::random_access_range<RA> && std::ranges::sized_range<RA>
+                      && std::ranges::random_access_range<RB> && std::ranges::sized_range<RB>) {
+            auto n = std::min<std::ptrdiff_t>(
+                static_cast<std::ptrdiff_t>(std::ranges::size(a)),
+                static_cast<std::ptrdiff_t>(std::ranges::size(b))
+            );
+            return make_begin(a, b) + n;
+        } else {
+            using Sent = details::
+                ZipSentinel<std::ranges::sentinel_t<RA>, std::ranges::sentinel_t<RB>>;
+            return Sent{std::ranges::end(a), std::ranges::end(b)};
+        }
+    }
+
+    A _a{};
+    B _b{};
+};
+
+template<typename A, typename B>
+ZipView(A&&, B&&) -> ZipView<std::views::all_t<A>, std::views::all_t<B>>;
+
+// Lazy view over consecutive, non-overlapping subranges of `n` elements. The last chunk
+// holds the remainder when the range does not divide evenly.
+template<std::ranges::view V>
+    requires std::ranges::forward_range<V>
+class ChunkView : public std::ranges::view_interface<ChunkView<V>> {
+public:
+    using difference_type = std::ranges::range_difference_t<V>;
+
+    ChunkView() = default;
+
+    ChunkView(V base, difference_type n) : _base{std::move(base)}, _n{n} {
+        AOC_ASSERT(n > 0, "chunk size must be positive");
+    }
+
+    auto begin() {
+        return make_begin(_base, _n);
+    }
+
+    auto begin() const
+        requires std::ranges::forward_range<const V>
+    {
+        return make_begin(_base, _n);
+    }
+
+    auto end() const {
+        return std::default_sentinel;
+    }
+
+    auto size() const
+        requires std::ranges::sized_range<const V>
+    {
+        auto n = static_cast<std::ranges::range_size_t<const V>>(_n);
+        return (std::ranges::size(_base) + n - 1) / n;
+    }
+
+private:
+    template<typename R>
+    static auto make_begin(R& r, difference_type n) {
+        using Iter = details::
+            ChunkIterator<std::ranges::iterator_t<R>, std::ranges::sentinel_t<R>>;
+        return Iter{std::ranges::begin(r), std::ranges::end(r), n};
+    }
+
+    V _base{};
+    difference_type _n{};
+};
+
+template<typename R>
+ChunkView(R&&, std::ranges::range_difference_t<R>) -> ChunkView<std::views::all_t<R>>;
+
+template<std::ranges::viewable_range A, std::ranges::viewable_range B>
+auto zip(A&& a, B&& b) {
+    return ZipView{std::forward<A>(a), std::forward<B>(b)};
+}
+
+// pairs of (index, element), like python's `enumerate`
+template<std::ranges::viewable_range R>
+auto enumerate(R&& r) {
+    if constexpr (std::ranges::sized_range<R>) {
+        auto n = static_cast<usize>(std::ranges::size(r));
+        return zip(std::views::iota(usize{0}, n), std::forward<R>(r));
+    } else {
+        return zip(std::views::iota(usize{0}), std::forward<R>(r));
+    }
+}
+
+template<std::ranges::viewable_range R>
+auto chunk(R&& r, std::ranges::range_difference_t<R> n) {
+    return ChunkView{std::forward<R>(r), n};
 }
 
+// Minimal allocator for storage aligned to `Align` bytes, e.g. a cache line so that
+// vectorized loops over a column start on an aligned load.
+template<typename T, usize Align = 64>
+struct AlignedAllocator {
+    static_assert(Align >= alignof(T), "alignment must satisfy the element type");
+
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    constexpr AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+
+    [[nodiscard]]
+    T* allocate(usize n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Align}));
+    }
+
+    void deallocate(T* p, usize) noexcept {
+        ::operator delete(p, std::align_val_t{Align});
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Align>&) const noexcept {
+        return true;
+    }
+};
+
+// Structure of arrays: each field is stored in its own contiguous, aligned column so that
+// loops touching a single field only pull that field through the cache (and can be
+// vectorized). Rows are accessed through tuples of references, e.g.:
+//
+//   enum Field { Src, Dst, Length };
+//   aoc::SoA<u64, u64, u64> ranges{{98, 50, 2}, {50, 52, 48}};
+//   auto [src, dst, length] = ranges[1];  // references into each column
+//   for (auto len : ranges.column<Length>()) { ... }
+template<typename... Fields>
+class SoA {
+    static_assert(sizeof...(Fields) > 0, "SoA requires at least one field");
+
+public:
+    static constexpr usize alignment = 64;
+
+    template<typename T>
+    using column_type = std::vector<T, AlignedAllocator<T, alignment>>;
+
+    using value_type = std::tuple<Fields...>;
+    using reference = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+
+    SoA() = default;
+
+    SoA(std::initializer_list<value_type> rows) {
+        reserve(rows.size());
+        for (const auto& row : rows) {
+            push_back(row);
+        }
+    }
+
+    [[nodiscard]]
+    usize size() const {
+        return std::get<0>(_columns).size();
+    }
+
+    [[nodiscard]]
+    bool empty() const {
+        return size() == 0;
+    }
+
+    void reserve(usize n) {
+        std::apply([n](auto&... col) { (col.reserve(n), ...); }, _columns);
+    }
+
+    void clear() {
+        std::apply([](auto&... col) { (col.clear(), ...); }, _columns);
+    }
+
+    void emplace_back(Fields... values) {
+        std::apply(
+            [&values...](auto&... col) { (col.push_back(std::move(values)), ...); },
+            _columns
+        );
+    }
+
+    void push_back(const value_type& row) {
+        std::apply([this](const auto&... values) { emplace_back(values...); }, row);
+    }
+
+    reference operator[](usize i) {
+        return std::apply([i](auto&... col) { return reference{col[i]...}; }, _columns);
+    }
+
+    const_reference operator[](usize i) const {
+        return std::apply(
+            [i](const auto&... col) { return const_reference{col[i]...}; },
+            _columns
+        );
+    }
+
+    template<usize I>
+    [[nodiscard]]
+    auto column() {
+        return std::span{std::get<I>(_columns)};
+    }
+
+    template<usize I>
+    [[nodiscard]]
+    auto column() const {
+        return std::span{std::get<I>(_columns)};
+    }
+
+    // random access view of row references
+    [[nodiscard]]
+    auto rows() {
+        return std::views::iota(usize{0}, size())
+            | std::views::transform([this](usize i) { return (*this)[i]; });
+    }
+
+    [[nodiscard]]
+    auto rows() const {
+        return std::views::iota(usize{0}, size())
+            | std::views::transform([this](usize i) { return (*this)[i]; });
+    }
+
+private:
+    std::tuple<column_type<Fields>...> _columns{};
+};
+
+// Vector with inline storage for `N` elements, only allocating once it grows past that.
+// Meant for short per-line or per-node collections where a heap allocation costs more than
+// the work done with the elements.
+template<typename T, usize N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector requires inline capacity");
+
+public:
+    using value_type = T;
+    using size_type = usize;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() = default;
+
+    SmallVector(std::initializer_list<T> values) : SmallVector(values.begin(), values.end()) {}
+
+    template<std::input_iterator It, std::sentinel_for<It> Sent>
+    SmallVector(It first, Sent last) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector(other.begin(), other.end()) {}
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        take(std::move(other));
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size());
+            std::uninitialized_copy(other.begin(), other.end(), _data);
+            _size = other.size();
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            release();
+            take(std::move(other));
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        release();
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (_size == _capacity) {
+            return grow_and_emplace(std::forward<Args>(args)...);
+        }
+        T* el = std::construct_at(_data + _size, std::forward<Args>(args)...);
+        ++_size;
+        return *el;
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() {
+        AOC_ASSERT(_size > 0, "cannot pop from an empty SmallVector");
+        std::destroy_at(_data + --_size);
+    }
+
+    void clear() {
+        std::destroy_n(_data, _size);
+        _size = 0;
+    }
+
+    void reserve(usize n) {
+        if (n > _capacity) {
+            grow(n);
+        }
+    }
+
+    [[nodiscard]]
+    usize size() const {
+        return _size;
+    }
+
+    [[nodiscard]]
+    usize capacity() const {
+        return _capacity;
+    }
+
+    [[nodiscard]]
+    bool empty() const {
+        return _size == 0;
+    }
+
+    // true while the elements still live in the inline buffer
+    [[nodiscard]]
+    bool is_inline() const {
+        return _data == inline_data();
+    }
+
+    T& operator[](usize i) {
+        return _data[i];
+    }
+
+    const T& operator[](usize i) const {
+        return _data[i];
+    }
+
+    T& at(usize i) {
+        AOC_ASSERT(i < _size, "SmallVector index out of range");
+        return _data[i];
+    }
+
+    [[nodiscard]]
+    const T& at(usize i) const {
+        AOC_ASSERT(i < _size, "SmallVector index out of range");
+        return _data[i];
+    }
+
+    T& front() {
+        return _data[0];
+    }
+
+    const T& front() const {
+        return _data[0];
+    }
+
+    T& back() {
+        return _data[_size - 1];
+    }
+
+    const T& back() const {
+        return _data[_size - 1];
+    }
+
+    T* data() {
+        return _data;
+    }
+
+    const T* data() const {
+        return _data;
+    }
+
+    iterator begin() {
+        return _data;
+    }
+
+    const_iterator begin() const {
+        return _data;
+    }
+
+    iterator end() {
+        return _data + _size;
+    }
+
+    const_iterator end() const {
+        return _data + _size;
+    }
+
+    friend bool operator==(const SmallVector& lhs, const SmallVector& rhs) {
+        return std::ranges::equal(lhs, rhs);
+    }
+
+    friend auto operator<=>(const SmallVector& lhs, const SmallVector& rhs)
+        requires std::three_way_comparable<T>
+    {
+        return std::lexicographical_compare_three_way(
+            lhs.begin(),
+            lhs.end(),
+            rhs.begin(),
+            rhs.end()
+        );
+    }
+
+private:
+    T* inline_data() {
+        return std::launder(reinterpret_cast<T*>(_inline.data()));
+    }
+
+    [[nodiscard]]
+    const T* inline_data() const {
+        return std::launder(reinterpret_cast<const T*>(_inline.data()));
+    }
+
+    static T* allocate(usize capacity) {
+        return static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t{alignof(T)}));
+    }
+
+    void grow(usize capacity) {
+        adopt(allocate(capacity), capacity);
+    }
+
+    // `args` may refer to an element of this vector (`v.push_back(v[0])`), so the new element
+    // is constructed in the new storage before the old elements are moved out of the way
+    template<typename... Args>
+    T& grow_and_emplace(Args&&... args) {
+        const usize capacity = _capacity * 2;
+        T* data = allocate(capacity);
+        T* el{};
+        try {
+            el = std::construct_at(data + _size, std::forward<Args>(args)...);
+        } catch (...) {
+            ::operator delete(data, std::align_val_t{alignof(T)});
+            throw;
+        }
+        adopt(data, capacity);
+        ++_size;
+        return *el;
+    }
+
+    // moves the elements into `data`, which has room for `capacity`, and frees the old storage
+    void adopt(T* data, usize capacity) {
+        std::uninitialized_move(_data, _data + _size, data);
+        std::destroy_n(_data, _size);
+        if (!is_inline()) {
+            ::operator delete(_data, std::align_val_t{alignof(T)});
+        }
+        _data = data;
+        _capacity = capacity;
+    }
+
+    // destroys all elements and frees any heap storage, leaving an empty inline vector
+    void release() {
+        clear();
+        if (!is_inline()) {
+            ::operator delete(_data, std::align_val_t{alignof(T)});
+        }
+        _data = inline_data();
+        _capacity = N;
+    }
+
+    // steals heap storage, or moves elements out of the inline buffer of `other`
+    void take(SmallVector&& other) {
+        if (other.is_inline()) {
+            std::uninitialized_move(other.begin(), other.end(), _data);
+            _size = other._size;
+            other.clear();
+        } else {
+            _data = std::exchange(other._data, other.inline_data());
+            _size = std::exchange(other._size, 0);
+            _capacity = std::exchange(other._capacity, N);
+        }
+    }
+
+    alignas(T) std::array<std::byte, N * sizeof(T)> _inline{};
+    T* _data{inline_data()};
+    usize _size{};
+    usize _capacity{N};
+};
+
+// Set stored as a sorted, unique vector. Lookups are a branchless binary search over
+// contiguous memory, which beats node based sets for the small, read-mostly sets used
+// while solving.
+template<typename T, typename Compare = std::less<>>
+class FlatSet {
+public:
+    using value_type = T;
+    using size_type = usize;
+    using iterator = typename std::vector<T>::const_iterator;
+    using const_iterator = iterator;
+
+    FlatSet() = default;
+
+    FlatSet(std::initializer_list<T> values) : _inner{values} {
+        normalize();
+    }
+
+    template<std::ranges::input_range R>
+    explicit FlatSet(R&& values) : _inner{std::ranges::begin(values), std::ranges::end(values)} {
+        normalize();
+    }
+
+    // returns false if the value was already present
+    bool insert(const T& value) {
+        auto it = lower_bound(value);
+        if (it != end() && !_comp(value, *it)) {
+            return false;
+        }
+        _inner.insert(it, value);
+        return true;
+    }
+
+    bool erase(const T& value) {
+        auto it = find(value);
+        if (it == end()) {
+            return false;
+        }
+        _inner.erase(it);
+        return true;
+    }
+
+    [[nodiscard]]
+    bool contains(const T& value) const {
+        return find(value) != end();
+    }
+
+    [[nodiscard]]
+    iterator find(const T& value) const {
+        auto it = lower_bound(value);
+        if (it != end() && !_comp(value, *it)) {
+            return it;
+        }
+        return end();
+    }
+
+    // first element not ordered before `value`
+    [[nodiscard]]
+    iterator lower_bound(const T& value) const {
+        return begin() + static_cast<std::ptrdiff_t>(partition_point([&](const T& el) {
+                   return _comp(el, value);
+               }));
+    }
+
+    // first element ordered after `value`
+    [[nodiscard]]
+    iterator upper_bound(const T& value) const {
+        return begin() + static_cast<std::ptrdiff_t>(partition_point([&](const T& el) {
+                   return !_comp(value, el);
+               }));
+    }
+
+    void reserve(usize n) {
+        _inner.reserve(n);
+    }
+
+    void clear() {
+        _inner.clear();
+    }
+
+    [[nodiscard]]
+    usize size() const {
+        return _inner.size();
+    }
+
+    [[nodiscard]]
+    bool empty() const {
+        return _inner.empty();
+    }
+
+    [[nodiscard]]
+    iterator begin() const {
+        return _inner.begin();
+    }
+
+    [[nodiscard]]
+    iterator end() const {
+        return _inner.end();
+    }
+
+    bool operator==(const FlatSet& other) const {
+        return _inner == other._inner;
+    }
+
+private:
+    void normalize() {
+        std::ranges::sort(_inner, _comp);
+        auto [first, last] = std::ranges::unique(_inner, [this](const T& a, const T& b) {
+            return !_comp(a, b) && !_comp(b, a);
+        });
+        _inner.erase(first, last);
+    }
+
+    // index of the first element where `pred` is false, where the loop has a fixed trip
+    // count for a given size and the select compiles to a conditional move
+    template<typename Pred>
+    [[nodiscard]]
+    usize partition_point(Pred pred) const {
+        if (_inner.empty()) {
+            return 0;
+        }
+
+        const T* base = _inner.data();
+        usize n = _inner.size();
+        while (n > 1) {
+            usize half = n / 2;
+            base = pred(base[half]) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<usize>(base - _inner.data()) + static_cast<usize>(pred(*base));
+    }
+
+    std::vector<T> _inner{};
+    [[no_unique_address]] Compare _comp{};
+};
+
 }  // namespace aoc
@@ -1,7 +1,21 @@
 #pragma once
 
+#include "aoc/alloc.hpp"
+#include "aoc/perf.hpp"
+#include "aoc/types.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <ostream>
 #include <source_location>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include <fmt/core.h>  // IWYU pragma: export
 #include <fmt/format.h>  // IWYU pragma: export
@@ -33,13 +47,60 @@ namespace aoc {
         }                                                             \
     } while (0)
 
+// like `AOC_ASSERT`, but takes a format string and arguments that are only formatted when
+// the assertion fails
+#define AOC_ASSERTF(expr, ...)                                        \
+    do {                                                              \
+        /* NOLINTNEXTLINE(readability-simplify-boolean-expr) */       \
+        if (!(expr)) {                                                \
+            spdlog::error("FAILED ASSERTION: `{}`", STRINGIFY(expr)); \
+            ::aoc::panic(fmt::format(__VA_ARGS__));                   \
+        }                                                             \
+    } while (0)
+
+// debug assertions are meant for hot paths and are compiled out of release builds, unless
+// `AOC_ENABLE_DEBUG_ASSERTS` is set explicitly (see `AOC_DEBUG_ASSERTS` in CMake)
+#if !defined(AOC_ENABLE_DEBUG_ASSERTS)
+#  if defined(NDEBUG)
+#    define AOC_ENABLE_DEBUG_ASSERTS 0
+#  else
+#    define AOC_ENABLE_DEBUG_ASSERTS 1
+#  endif
+#endif
+
+#if AOC_ENABLE_DEBUG_ASSERTS
+#  define AOC_DEBUG_ASSERT(expr, msg) AOC_ASSERT(expr, msg)
+#  define AOC_DEBUG_ASSERTF(expr, ...) AOC_ASSERTF(expr, __VA_ARGS__)
+#else
+// the expression is kept in an unevaluated operand so it still has to compile, and
+// anything it names does not trigger unused warnings
+#  define AOC_DEBUG_ASSERT(expr, msg) static_cast<void>(sizeof(!(expr)))
+#  define AOC_DEBUG_ASSERTF(expr, ...) static_cast<void>(sizeof(!(expr)))
+#endif
+
 // NOLINTEND(cppcoreguidelines-macro-usage)
 
+// thrown by `panic` instead of stopping the process, see `set_panics_throw`
+class PanicError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Panics break into the debugger or abort by default. Processes that should report a bad
+// input and carry on with the next one (the runner's batch and server modes) can have them
+// throw `PanicError` instead, on every thread.
+void set_panics_throw(bool enabled);
+[[nodiscard]]
+bool panics_throw();
+
 template<typename T>
 [[noreturn]]
 constexpr void panic(T&& msg, std::source_location location = std::source_location::current()) {
-    spdlog::
-        critical("PANIC: {} ({}:{})", std::forward<T>(msg), location.file_name(), location.line());
+    auto message = fmt::format("{}", std::forward<T>(msg));
+    spdlog::critical("PANIC: {} ({}:{})", message, location.file_name(), location.line());
+    if (panics_throw()) {
+        throw PanicError{message};
+    }
     AOC_DEBUGBREAK();
     abort();
 }
@@ -65,4 +126,142 @@ constexpr void unused(T&& arg, Args... args) {
     unused(std::forward<Args...>(args...));
 }
 
+using Clock = std::chrono::steady_clock;
+
+struct PhaseStats {
+    std::string name{};
+    usize calls{};
+    Clock::duration total{};
+    Clock::duration min{Clock::duration::max()};
+    Clock::duration max{};
+
+    // hardware counters summed over the calls that had them (see `PerfCounters`)
+    PerfSample counters{};
+    usize counted_calls{};
+    // input bytes summed over the counted calls, 0 if the phase did not give its input size
+    u64 input_bytes{};
+
+    // allocations summed over all calls, with the highest peak of any call (see `AllocStats`)
+    AllocStats allocs{};
+};
+
+// measurements from a single run of a phase
+struct PhaseSample {
+    Clock::time_point start{};
+    Clock::duration elapsed{};
+    std::optional<PerfSample> counters{};
+    AllocStats allocs{};
+    usize input_bytes{};
+};
+
+// Process-wide table of named phases (e.g. "parse", "part1"), in the order they were first
+// used. When the process exits, a summary goes to stderr (unless `AOC_TIMING=0`), and a JSON
+// report is written to the path in `AOC_TIMING_JSON`, if that is set. With `AOC_PERF=1`, the
+// summary also has hardware counters per phase, normalized by the input each phase worked on
+// (see `ScopedTimer`), and builds with `AOC_TRACK_ALLOCS` add allocation counts.
+//
+// Setting `AOC_TRACE_JSON=<path>` also keeps phase runs as Chrome trace events, written at exit
+// so the run can be opened as a timeline in `chrome://tracing` or Perfetto. Only the most recent
+// `trace_capacity()` events are kept, so long `--serve` or `--bench` runs stay bounded.
+class PhaseRegistry {
+public:
+    PhaseRegistry(const PhaseRegistry&) = delete;
+    PhaseRegistry(PhaseRegistry&&) = delete;
+    PhaseRegistry& operator=(const PhaseRegistry&) = delete;
+    PhaseRegistry& operator=(PhaseRegistry&&) = delete;
+    ~PhaseRegistry() = default;
+
+    static PhaseRegistry& instance();
+
+    // registers the phase on first use
+    usize id(std::string_view name);
+    void record(usize id, const PhaseSample& sample);
+
+    [[nodiscard]]
+    std::vector<PhaseStats> stats() const;
+    // stats of one phase, e.g. for a driver's own report, empty if it was never used
+    [[nodiscard]]
+    std::optional<PhaseStats> find(std::string_view name) const;
+    void clear();
+
+    void print_summary(std::FILE* out) const;
+    void write_json(std::ostream& os) const;
+
+    [[nodiscard]]
+    bool tracing() const;
+    void set_tracing(bool enabled);
+    [[nodiscard]]
+    usize trace_capacity() const;
+    // drops the oldest events beyond the new capacity
+    void set_trace_capacity(usize capacity);
+    // labels the calling thread in traces, other threads show up as `thread <index>`
+    void set_thread_name(std::string_view name);
+    void write_trace(std::ostream& os) const;
+
+    void report_at_exit() const;
+
+private:
+    struct TraceEvent {
+        usize phase{};
+        u32 thread{};
+        Clock::time_point start{};
+        Clock::duration elapsed{};
+        AllocStats allocs{};
+    };
+
+    // about 12 MiB of events
+    static constexpr usize DEFAULT_TRACE_CAPACITY{1 << 18};
+
+    PhaseRegistry();
+
+    mutable std::mutex _mutex{};
+    std::vector<PhaseStats> _phases{};
+
+    bool _tracing{};
+    Clock::time_point _epoch{};
+    // ring of the latest events once it reaches `_trace_capacity`, `_next_event` is the oldest
+    std::vector<TraceEvent> _events{};
+    usize _trace_capacity{DEFAULT_TRACE_CAPACITY};
+    usize _next_event{};
+    u64 _dropped_events{};
+    std::vector<std::pair<u32, std::string>> _thread_names{};
+};
+
+// small sequential id for the calling thread, assigned on first use
+u32 thread_index();
+
+// Records the time between construction and destruction under a phase name, along with
+// hardware counters and the calling thread's allocations when they are enabled. Counters
+// include the work the phase hands to the thread pool or a pipeline (see `PerfHandoff`).
+// `input_bytes` is the size of the input the phase works on, which the counter report divides
+// by. Phases that leave it at 0 use `aoc::input_bytes()`, which is right for executables that
+// read one file.
+class ScopedTimer {
+public:
+    explicit ScopedTimer(std::string_view phase, usize input_bytes = 0);
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer(ScopedTimer&&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(ScopedTimer&&) = delete;
+    ~ScopedTimer();
+
+    [[nodiscard]]
+    Clock::duration elapsed() const;
+
+private:
+    usize _phase{};
+    usize _input_bytes{};
+    const PerfCounters* _perf{};
+    PerfSample _perf_start{};
+    AllocMark _alloc{};
+    Clock::time_point _start{};
+};
+
+// runs `fn` inside a phase and returns its result
+template<typename F>
+decltype(auto) timed(std::string_view phase, F&& fn) {
+    ScopedTimer timer{phase};
+    return std::invoke(std::forward<F>(fn));
+}
+
 }  // namespace aoc
@@ -1,10 +1,23 @@
 #pragma once
 
+#include "aoc/generator.hpp"
+#include "aoc/types.hpp"
+
 #include <filesystem>
 #include <fstream>
+#include <string>
 
 namespace aoc {
 
 std::fstream open(const std::filesystem::path& path);
 
+// Yields the lines of a file opened with `aoc::open` one at a time, without newlines. Each
+// line is overwritten by the next, so callers move it out to keep it.
+Generator<std::string> read_lines(std::filesystem::path path);
+
+// total size of the distinct files read with `aoc::open`, used to normalize the hardware
+// counters of phases that do not give their own input size. Files are only recorded while
+// counters are enabled (`AOC_PERF=1`), otherwise this is 0.
+usize input_bytes();
+
 }  // namespace aoc
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "aoc/types.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Lazy sequence produced by a coroutine, which runs up to its next `co_yield` each time the
+// iterator is advanced. It is a move-only input range that can be iterated once, e.g.
+//
+//     Generator<int> count(int n) {
+//         for (int i = 0; i < n; ++i) {
+//             co_yield i;
+//         }
+//     }
+//
+// Yielded values are not copied: the iterator refers to the yielded object until the next
+// increment, and may move from it. Exceptions thrown in the coroutine surface where it is
+// resumed. Arguments are only read once iteration starts, so a generator should take its
+// parameters by value.
+template<typename T>
+class Generator : public std::ranges::view_interface<Generator<T>> {
+public:
+    struct promise_type {
+        T* value{};
+        std::exception_ptr error{};
+
+        Generator get_return_object() {
+            return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+
+        // a yielded temporary lives until the coroutine resumes, so keeping its address is safe
+        std::suspend_always yield_value(T& v) noexcept {
+            value = std::addressof(v);
+            return {};
+        }
+
+        std::suspend_always yield_value(T&& v) noexcept {
+            value = std::addressof(v);
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept {
+            error = std::current_exception();
+        }
+
+        // generators only yield, awaiting inside one is a mistake
+        template<typename U>
+        std::suspend_never await_transform(U&&) = delete;
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    class Iterator {
+    public:
+        using value_type = std::remove_cvref_t<T>;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        explicit Iterator(Handle handle) : _handle{handle} {}
+
+        T& operator*() const {
+            return *_handle.promise().value;
+        }
+
+        T* operator->() const {
+            return _handle.promise().value;
+        }
+
+        Iterator& operator++() {
+            resume(_handle);
+            return *this;
+        }
+
+        void operator++(int) {
+            ++*this;
+        }
+
+        friend bool operator==(const Iterator& it, std::default_sentinel_t) {
+            return !it._handle || it._handle.done();
+        }
+
+    private:
+        Handle _handle{};
+    };
+
+    Generator() = default;
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+
+    Generator(Generator&& other) noexcept : _handle{std::exchange(other._handle, {})} {}
+
+    Generator& operator=(Generator&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            _handle = std::exchange(other._handle, {});
+        }
+        return *this;
+    }
+
+    ~Generator() {
+        destroy();
+    }
+
+    // runs the coroutine up to its first `co_yield`, can only be called once
+    Iterator begin() {
+        if (_handle) {
+            resume(_handle);
+        }
+        return Iterator{_handle};
+    }
+
+    std::default_sentinel_t end() const noexcept {
+        return {};
+    }
+
+private:
+    explicit Generator(Handle handle) : _handle{handle} {}
+
+    static void resume(Handle handle) {
+        handle.resume();
+        if (auto error = std::exchange(handle.promise().error, {})) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void destroy() {
+        if (_handle) {
+            _handle.destroy();
+        }
+    }
+
+    Handle _handle{};
+};
+
+// Drains a generator into a vector, moving every value out.
+template<typename T>
+std::vector<std::remove_cvref_t<T>> collect(Generator<T> gen) {
+    std::vector<std::remove_cvref_t<T>> result{};
+    for (auto& value : gen) {
+        result.push_back(std::move(value));
+    }
+    return result;
+}
+
+}  // namespace aoc
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "aoc/collections.hpp"
 #include "aoc/core.hpp"
 #include "aoc/hash.hpp"
 #include "aoc/types.hpp"
@@ -60,7 +61,7 @@ public:
         auto dx = static_cast<i64>(to.x) - static_cast<i64>(from.x);
         auto dy = static_cast<i64>(to.y) - static_cast<i64>(from.y);
 
-        AOC_ASSERT(
+        AOC_DEBUG_ASSERT(
             (std::abs(dx) + std::abs(dy)) == 1,
             "coordinates must be adjacent in a cardinal direction"
         );
@@ -81,10 +82,13 @@ public:
         aoc::unreachable();
     }
 
+    // at most four neighbors, so these never touch the heap
+    using Neighbors = SmallVector<Coord, 4>;
+
     [[nodiscard]]
-    std::vector<Coord> adjacent(Coord pos) const {
-        AOC_ASSERT(contains(pos), "grid must contain position");
-        std::vector<Coord> result{};
+    Neighbors adjacent(Coord pos) const {
+        AOC_DEBUG_ASSERT(contains(pos), "grid must contain position");
+        Neighbors result{};
 
         // north
         if (pos.y > 0) {
@@ -107,7 +111,7 @@ public:
     }
 
     [[nodiscard]]
-    std::vector<Coord> adjacent(usize x, usize y) const {
+    Neighbors adjacent(usize x, usize y) const {
         return adjacent({x, y});
     }
 
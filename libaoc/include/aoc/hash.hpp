@@ -1,6 +1,9 @@
 #pragma once
 
+#include "aoc/types.hpp"
+
 #include <functional>
+#include <string_view>
 
 namespace aoc {
 
@@ -17,4 +20,10 @@ void hash_combine(std::size_t& seed, const T& v, Ts&&... vs) {
     hash_combine(seed, std::forward<Ts>(vs)...);
 }
 
+// XXH64 of `data`, as specified in
+// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md. Meant for fingerprinting
+// whole files, not for hash tables.
+[[nodiscard]]
+u64 xxh64(std::string_view data, u64 seed = 0);
+
 }  // namespace aoc
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "aoc/types.hpp"
+
+#include <spdlog/spdlog.h>  // IWYU pragma: export
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define AOC_LOG_LEVEL_TRACE 0
+#define AOC_LOG_LEVEL_DEBUG 1
+#define AOC_LOG_LEVEL_INFO 2
+#define AOC_LOG_LEVEL_OFF 6
+
+// lowest level that is compiled in, anything below it is removed along with its arguments
+// (see `AOC_LOG_LEVEL` in CMake). defaults to everything for debug builds and info for
+// release builds.
+#if !defined(AOC_LOG_LEVEL)
+#  if defined(NDEBUG)
+#    define AOC_LOG_LEVEL AOC_LOG_LEVEL_INFO
+#  else
+#    define AOC_LOG_LEVEL AOC_LOG_LEVEL_TRACE
+#  endif
+#endif
+
+// arguments are only evaluated when the runtime level also allows the message
+#define AOC_LOG_IMPL(lvl, ...)                            \
+    do {                                                  \
+        if (spdlog::should_log(spdlog::level::lvl)) {     \
+            spdlog::log(spdlog::level::lvl, __VA_ARGS__); \
+        }                                                 \
+    } while (0)
+
+// elided calls still type check the format string and arguments, without evaluating them
+#define AOC_LOG_ELIDED(...) static_cast<void>(sizeof(fmt::format(__VA_ARGS__)))
+
+#if AOC_LOG_LEVEL <= AOC_LOG_LEVEL_TRACE
+#  define AOC_TRACE(...) AOC_LOG_IMPL(trace, __VA_ARGS__)
+#else
+#  define AOC_TRACE(...) AOC_LOG_ELIDED(__VA_ARGS__)
+#endif
+
+#if AOC_LOG_LEVEL <= AOC_LOG_LEVEL_DEBUG
+#  define AOC_DEBUG(...) AOC_LOG_IMPL(debug, __VA_ARGS__)
+#else
+#  define AOC_DEBUG(...) AOC_LOG_ELIDED(__VA_ARGS__)
+#endif
+
+#if AOC_LOG_LEVEL <= AOC_LOG_LEVEL_INFO
+#  define AOC_INFO(...) AOC_LOG_IMPL(info, __VA_ARGS__)
+#else
+#  define AOC_INFO(...) AOC_LOG_ELIDED(__VA_ARGS__)
+#endif
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+namespace aoc {
+
+constexpr usize DEFAULT_LOG_QUEUE_SIZE = 8192;
+
+// Replaces the default logger with one that formats on the calling thread but writes from a
+// background thread. The queue is bounded and drops the oldest messages when full, so
+// logging never blocks the caller. Pending messages are flushed at exit.
+void use_async_logger(usize queue_size = DEFAULT_LOG_QUEUE_SIZE);
+
+// Sets the runtime log level. If `AOC_LOG_ASYNC` is set in the environment, the async
+// logger is installed as well, using its value as the queue size when it is a number.
+void init_logging(spdlog::level::level_enum level);
+
+}  // namespace aoc
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "aoc/types.hpp"
+
+#include <array>
+#include <mutex>
+
+namespace aoc {
+
+// Hardware counter values, either cumulative or the difference between two reads.
+struct PerfSample {
+    u64 cycles{};
+    u64 instructions{};
+    u64 cache_misses{};
+    u64 branch_misses{};
+
+    [[nodiscard]]
+    double ipc() const {
+        if (cycles == 0) {
+            return 0.0;
+        }
+        return static_cast<double>(instructions) / static_cast<double>(cycles);
+    }
+
+    PerfSample& operator+=(const PerfSample& other) {
+        cycles += other.cycles;
+        instructions += other.instructions;
+        cache_misses += other.cache_misses;
+        branch_misses += other.branch_misses;
+        return *this;
+    }
+
+    // Reads are scaled estimates while the kernel multiplexes the counters, so a later read
+    // can come out lower than an earlier one. Those fields are clamped to 0 instead of
+    // wrapping around.
+    friend PerfSample operator-(const PerfSample& lhs, const PerfSample& rhs) {
+        auto delta = [](u64 a, u64 b) { return a > b ? a - b : u64{0}; };
+        return {
+            delta(lhs.cycles, rhs.cycles),
+            delta(lhs.instructions, rhs.instructions),
+            delta(lhs.cache_misses, rhs.cache_misses),
+            delta(lhs.branch_misses, rhs.branch_misses),
+        };
+    }
+};
+
+// Counts user space cycles, instructions, cache misses and branch misses for the calling
+// thread with `perf_event_open`. The counters are opened as one group so they are always
+// scheduled together, and reads are scaled if the kernel had to multiplex them.
+//
+// On other platforms, or when the kernel refuses (e.g. `perf_event_paranoid` or a
+// container without perf access), `available()` is false and reads return zeros. Events
+// the CPU does not support on their own are left at zero.
+class PerfCounters {
+public:
+    PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters(PerfCounters&&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+    PerfCounters& operator=(PerfCounters&&) = delete;
+    ~PerfCounters();
+
+    // counting is opt-in with `AOC_PERF=1`, since opening counters costs a few syscalls
+    // per thread and they are not available everywhere
+    [[nodiscard]]
+    static bool enabled();
+
+    // lazily opened counters for the calling thread
+    static PerfCounters& for_this_thread();
+
+    [[nodiscard]]
+    bool available() const {
+        return _fds[0] != -1;
+    }
+
+    // cumulative values since the counters were opened
+    [[nodiscard]]
+    PerfSample read() const;
+
+    // `read()`, plus what other threads counted while working for this one, minus what this
+    // thread counted while working for others (see `PerfHandoff`). Phases use these, so a
+    // phase that hands work to the thread pool also sees the workers' counters.
+    [[nodiscard]]
+    PerfSample read_attributed() const;
+
+    void add_delegated(const PerfSample& sample) {
+        _delegated += sample;
+    }
+
+    void add_lent(const PerfSample& sample) {
+        _lent += sample;
+    }
+
+private:
+    static constexpr usize EVENT_COUNT = 4;
+
+    std::array<int, EVENT_COUNT> _fds{-1, -1, -1, -1};
+    std::array<u64, EVENT_COUNT> _ids{};
+    PerfSample _delegated{};
+    PerfSample _lent{};
+};
+
+// Moves counters from threads doing work on behalf of another thread over to that thread, so
+// its phase includes them. The helping threads wrap that work in a `Scope`, and the thread it
+// was done for calls `settle` once every scope ended. Does nothing unless counting is enabled.
+class PerfHandoff {
+public:
+    class Scope {
+    public:
+        // counts nothing for a null `handoff`, e.g. when a thread runs its own work
+        explicit Scope(PerfHandoff* handoff);
+        Scope(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&) = delete;
+        ~Scope();
+
+    private:
+        PerfHandoff* _handoff{};
+        PerfCounters* _counters{};
+        PerfSample _start{};
+    };
+
+    // adds what the scopes counted to the calling thread's counters
+    void settle();
+
+private:
+    std::mutex _mutex{};
+    PerfSample _total{};
+};
+
+}  // namespace aoc
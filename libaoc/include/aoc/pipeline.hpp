@@ -0,0 +1,242 @@
+#pragma once
+
+#include "aoc/fs.hpp"
+#include "aoc/perf.hpp"
+#include "aoc/ring_buffer.hpp"
+#include "aoc/types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+struct PipelineOptions {
+    // parser threads, 0 leaves one hardware thread each to the reader and the reducer
+    usize parsers{};
+    // lines read before a batch is handed to a parser
+    usize batch_lines{256};
+    // batches each queue holds before its producer has to wait
+    usize queue_batches{16};
+};
+
+namespace details {
+    // yields before an idle stage goes to sleep, enough to ride out a short stall
+    constexpr usize PIPELINE_SPINS = 64;
+
+    // Shared state of one pipeline run. The first exception thrown by any stage is kept
+    // and every stage stops at its next queue operation.
+    //
+    // Every push, pop and change of state bumps `progress`. A stage that finds its queue
+    // empty (or full) reads `progress` before trying, and after a short spin sleeps until
+    // it changes, so a slow reader does not keep every parser busy polling.
+    struct PipelineState {
+        std::atomic<bool> reading_done{};
+        std::atomic<usize> parsers_left{};
+        std::atomic<bool> failed{};
+        std::atomic<u32> progress{};
+        std::mutex error_mutex{};
+        std::exception_ptr error{};
+
+        void fail() {
+            {
+                std::lock_guard lock{error_mutex};
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed.store(true, std::memory_order_release);
+            }
+            notify();
+        }
+
+        [[nodiscard]]
+        bool aborted() const {
+            return failed.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]]
+        u32 seen() const {
+            return progress.load(std::memory_order_acquire);
+        }
+
+        // wakes every stage waiting for progress
+        void notify() {
+            progress.fetch_add(1, std::memory_order_release);
+            progress.notify_all();
+        }
+
+        // waits for progress after `seen`, yielding for the first few calls of a wait
+        void wait(u32 seen, usize& spins) const {
+            if (spins++ < PIPELINE_SPINS) {
+                std::this_thread::yield();
+                return;
+            }
+            progress.wait(seen, std::memory_order_acquire);
+        }
+    };
+
+    // waits for room in a full queue, returns false if the pipeline was aborted
+    template<typename Queue, typename T>
+    bool push_or_wait(Queue& queue, T&& value, PipelineState& state) {
+        usize spins{};
+        while (true) {
+            auto seen = state.seen();
+            if (queue.try_push(std::move(value))) {
+                break;
+            }
+            if (state.aborted()) {
+                return false;
+            }
+            state.wait(seen, spins);
+        }
+        state.notify();
+        return true;
+    }
+}  // namespace details
+
+// Reads `path` on one thread, parses it on several and reduces the results on the calling
+// thread, so disk reads, parsing and solving overlap:
+//
+//     reader --SpscRing--> parser 1..N --MpscRing--> reduce (caller)
+//
+// The reader deals batches of lines to the parsers in turn. Each parser calls
+// `parse(const std::string&)` for every line of its batch and passes the records on as one
+// `std::vector`, which `reduce` receives by reference. Batches reach `reduce` in no
+// particular order, but records within one keep their input order. Exceptions from any
+// stage are rethrown here once every thread stopped. `parse` runs on several threads at
+// once, so it must not touch shared state.
+template<typename Parse, typename Reduce>
+void run_pipeline(
+    const std::filesystem::path& path,
+    Parse&& parse,
+    Reduce&& reduce,
+    PipelineOptions opts = {}
+) {
+    using Record = std::remove_cvref_t<std::invoke_result_t<Parse&, const std::string&>>;
+    using Lines = std::vector<std::string>;
+    using Records = std::vector<Record>;
+
+    auto parsers = opts.parsers;
+    if (parsers == 0) {
+        parsers = std::max(std::thread::hardware_concurrency(), 3U) - 2;
+    }
+    auto batch_lines = std::max(opts.batch_lines, usize{1});
+
+    // opened here, so a missing file throws before any thread starts
+    auto input = open(path);
+
+    details::PipelineState state{};
+    state.parsers_left = parsers;
+    std::vector<std::unique_ptr<SpscRing<Lines>>> line_queues{};
+    for (usize i = 0; i < parsers; ++i) {
+        line_queues.push_back(std::make_unique<SpscRing<Lines>>(opts.queue_batches));
+    }
+    MpscRing<Records> record_queue{opts.queue_batches * parsers};
+
+    // the stages' hardware counters belong to the caller's phase
+    PerfHandoff perf{};
+    std::vector<std::jthread> threads{};
+    threads.emplace_back([&] {
+        PerfHandoff::Scope counted{&perf};
+        try {
+            usize next{};
+            Lines batch{};
+            batch.reserve(batch_lines);
+            std::string line{};
+            while (std::getline(input, line)) {
+                batch.push_back(std::move(line));
+                if (batch.size() == batch_lines) {
+                    auto& queue = *line_queues[next++ % parsers];
+                    if (!details::push_or_wait(queue, std::move(batch), state)) {
+                        return;
+                    }
+                    batch = {};
+                    batch.reserve(batch_lines);
+                }
+            }
+            if (!batch.empty()) {
+                details::push_or_wait(*line_queues[next % parsers], std::move(batch), state);
+            }
+        } catch (...) {
+            state.fail();
+        }
+        state.reading_done.store(true, std::memory_order_release);
+        state.notify();
+    });
+
+    for (usize i = 0; i < parsers; ++i) {
+        threads.emplace_back([&, i] {
+            PerfHandoff::Scope counted{&perf};
+            auto& queue = *line_queues[i];
+            try {
+                usize spins{};
+                while (!state.aborted()) {
+                    auto seen = state.seen();
+                    // checked before popping: once reading is done, an empty queue stays empty
+                    auto done = state.reading_done.load(std::memory_order_acquire);
+                    auto lines = queue.try_pop();
+                    if (!lines.has_value()) {
+                        if (done) {
+                            break;
+                        }
+                        state.wait(seen, spins);
+                        continue;
+                    }
+                    spins = 0;
+                    state.notify();
+
+                    Records records{};
+                    records.reserve(lines->size());
+                    for (const auto& l : *lines) {
+                        records.push_back(parse(l));
+                    }
+                    if (!details::push_or_wait(record_queue, std::move(records), state)) {
+                        break;
+                    }
+                }
+            } catch (...) {
+                state.fail();
+            }
+            state.parsers_left.fetch_sub(1, std::memory_order_release);
+            state.notify();
+        });
+    }
+
+    try {
+        usize spins{};
+        while (!state.aborted()) {
+            auto seen = state.seen();
+            auto done = state.parsers_left.load(std::memory_order_acquire) == 0;
+            auto records = record_queue.try_pop();
+            if (!records.has_value()) {
+                if (done) {
+                    break;
+                }
+                state.wait(seen, spins);
+                continue;
+            }
+            spins = 0;
+            state.notify();
+            reduce(*records);
+        }
+    } catch (...) {
+        state.fail();
+    }
+
+    threads.clear();
+    perf.settle();
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+}
+
+}  // namespace aoc
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "aoc/types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread. The
+// capacity is rounded up to a power of two. Both sides only ever touch their own index and
+// read the other one, so an operation is a couple of atomic loads and one store.
+template<typename T>
+class SpscRing {
+public:
+    explicit SpscRing(usize capacity)
+        : _slots(std::bit_ceil(std::max(capacity, usize{1}))),
+          _mask{_slots.size() - 1} {}
+
+    [[nodiscard]]
+    usize capacity() const {
+        return _slots.size();
+    }
+
+    // moves `value` in and returns true, or leaves it alone if the queue is full
+    bool try_push(T&& value) {
+        auto tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head_cache == _slots.size()) {
+            _head_cache = _head.load(std::memory_order_acquire);
+            if (tail - _head_cache == _slots.size()) {
+                return false;
+            }
+        }
+        _slots[tail & _mask] = std::move(value);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> try_pop() {
+        auto head = _head.load(std::memory_order_relaxed);
+        if (head == _tail_cache) {
+            _tail_cache = _tail.load(std::memory_order_acquire);
+            if (head == _tail_cache) {
+                return {};
+            }
+        }
+        std::optional<T> value{std::move(_slots[head & _mask])};
+        _head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+private:
+    std::vector<T> _slots;
+    usize _mask;
+
+    // consumer side, `_tail_cache` is the last tail it saw
+    alignas(details::CACHE_LINE) std::atomic<usize> _head{};
+    usize _tail_cache{};
+    // producer side, `_head_cache` is the last head it saw
+    alignas(details::CACHE_LINE) std::atomic<usize> _tail{};
+    usize _head_cache{};
+};
+
+// Bounded lock-free queue for any number of producer threads and one consumer thread. Every
+// slot carries a sequence number that says whether it is free for the producer claiming that
+// position, or filled for the consumer (Vyukov's bounded queue).
+template<typename T>
+class MpscRing {
+public:
+    // at least two slots, with one the sequence numbers of "filled" and "free for the next
+    // lap" would be the same
+    explicit MpscRing(usize capacity)
+        : _slots(std::bit_ceil(std::max(capacity, usize{2}))),
+          _mask{_slots.size() - 1} {
+        for (usize i = 0; i < _slots.size(); ++i) {
+            _slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]]
+    usize capacity() const {
+        return _slots.size();
+    }
+
+    // moves `value` in and returns true, or leaves it alone if the queue is full
+    bool try_push(T&& value) {
+        auto pos = _tail.load(std::memory_order_relaxed);
+        while (true) {
+            auto& slot = _slots[pos & _mask];
+            auto seq = slot.seq.load(std::memory_order_acquire);
+            if (seq == pos) {
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (seq < pos) {
+                // the consumer has not freed this slot since the last lap
+                return false;
+            } else {
+                pos = _tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::optional<T> try_pop() {
+        auto& slot = _slots[_head & _mask];
+        if (slot.seq.load(std::memory_order_acquire) != _head + 1) {
+            return {};
+        }
+        std::optional<T> value{std::move(slot.value)};
+        // free the slot for the producer one lap ahead
+        slot.seq.store(_head + _slots.size(), std::memory_order_release);
+        _head++;
+        return value;
+    }
+
+private:
+    struct Slot {
+        std::atomic<usize> seq{};
+        T value{};
+    };
+
+    std::vector<Slot> _slots;
+    usize _mask;
+
+    alignas(details::CACHE_LINE) std::atomic<usize> _tail{};
+    // only the consumer touches it
+    alignas(details::CACHE_LINE) usize _head{};
+};
+
+}  // namespace aoc
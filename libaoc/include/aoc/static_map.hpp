@@ -0,0 +1,137 @@
+#pragma once
+
+#include "aoc/core.hpp"
+#include "aoc/types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <string_view>
+
+namespace aoc {
+
+// string literal wrapper so that keywords can be passed as template arguments
+template<usize N>
+struct fixed_string {
+    std::array<char, N> data{};
+
+    // NOLINTNEXTLINE(google-explicit-constructor, *-avoid-c-arrays)
+    constexpr fixed_string(const char (&s)[N]) {
+        std::copy_n(s, N, data.begin());
+    }
+
+    [[nodiscard]]
+    constexpr std::string_view view() const {
+        return {data.data(), N - 1};
+    }
+};
+
+namespace details {
+    struct PerfectHash {
+        u64 seed{};
+        usize buckets{};
+    };
+
+    // seeded FNV-1a, folded and masked to a power of two table
+    constexpr usize perfect_hash(std::string_view s, u64 seed, usize buckets) {
+        u64 h = 0xcbf29ce484222325ULL ^ seed;
+        for (char c : s) {
+            h ^= static_cast<u8>(c);
+            h *= 0x100000001b3ULL;
+        }
+        h ^= h >> 29;
+        return static_cast<usize>(h) & (buckets - 1);
+    }
+
+    template<usize N>
+    constexpr PerfectHash find_perfect_hash(const std::array<std::string_view, N>& keys) {
+        auto sorted = keys;
+        std::ranges::sort(sorted);
+        if (std::ranges::adjacent_find(sorted) != sorted.end()) {
+            aoc::panic("static_map keys must be unique");
+        }
+
+        // start with the smallest table that fits every key, and make it sparser
+        // whenever none of the seeds give a collision free mapping
+        constexpr u64 max_seeds = 1024;
+        constexpr usize max_buckets = 1 << 16;
+        usize buckets = 1;
+        while (buckets < N) {
+            buckets <<= 1;
+        }
+
+        for (; buckets <= max_buckets; buckets <<= 1) {
+            for (u64 seed = 0; seed < max_seeds; ++seed) {
+                std::array<usize, N> slots{};
+                std::ranges::transform(keys, slots.begin(), [&](auto key) {
+                    return perfect_hash(key, seed, buckets);
+                });
+                std::ranges::sort(slots);
+                if (std::ranges::adjacent_find(slots) == slots.end()) {
+                    return {seed, buckets};
+                }
+            }
+        }
+
+        aoc::panic("could not find a perfect hash for static_map keys");
+    }
+}  // namespace details
+
+// Maps a fixed set of keywords to dense indices `[0, size())` in declaration order. The
+// table is generated at compile time so that a lookup is one hash and one compare, e.g.:
+//
+//   using Colors = aoc::static_map<"red", "green", "blue">;
+//   static_assert(Colors::index("blue") == 2);
+//   std::array<int, Colors::size()> counts{};
+//   counts[Colors::index(color)]++;
+template<fixed_string... Keys>
+class static_map {
+    static_assert(sizeof...(Keys) > 0, "static_map requires at least one key");
+
+public:
+    static constexpr std::array<std::string_view, sizeof...(Keys)> keys{Keys.view()...};
+
+    [[nodiscard]]
+    static constexpr usize size() {
+        return sizeof...(Keys);
+    }
+
+    [[nodiscard]]
+    static constexpr std::optional<usize> find(std::string_view key) {
+        auto slot = SLOTS[details::perfect_hash(key, HASH.seed, HASH.buckets)];
+        if (slot < size() && keys[slot] == key) {
+            return slot;
+        }
+        return {};
+    }
+
+    [[nodiscard]]
+    static constexpr bool contains(std::string_view key) {
+        return find(key).has_value();
+    }
+
+    // like `find`, but panics for unknown keys (a compile error in constant expressions)
+    [[nodiscard]]
+    static constexpr usize index(std::string_view key) {
+        auto idx = find(key);
+        if (!idx.has_value()) {
+            aoc::panic(fmt::format("unknown key `{}`", key));
+        }
+        return idx.value();
+    }
+
+private:
+    static constexpr details::PerfectHash HASH = details::find_perfect_hash(keys);
+
+    // bucket -> key index, where empty buckets hold an out of range index
+    static constexpr auto SLOTS = [] {
+        std::array<usize, HASH.buckets> slots{};
+        slots.fill(sizeof...(Keys));
+        for (usize i = 0; i < keys.size(); ++i) {
+            slots.at(details::perfect_hash(keys.at(i), HASH.seed, HASH.buckets)) = i;
+        }
+        return slots;
+    }();
+};
+
+}  // namespace aoc
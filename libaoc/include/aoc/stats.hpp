@@ -0,0 +1,45 @@
+#pragma once
+
+#include "aoc/types.hpp"
+
+#include <span>
+#include <string>
+
+namespace aoc {
+
+// Summary of repeated measurements, e.g. run times in nanoseconds.
+//
+// The order statistics use every sample, since the slow tail is what a caller actually
+// sees. `mean` and `stddev` skip outliers outside the Tukey fences (more than 1.5 IQR
+// beyond the quartiles), which are usually one-off stalls like page faults or preemption.
+struct Distribution {
+    usize samples{};
+    usize outliers{};
+    f64 min{};
+    f64 median{};
+    f64 p90{};
+    f64 p99{};
+    f64 max{};
+    f64 mean{};
+    f64 stddev{};
+};
+
+// Interpolates between the closest ranks of `sorted`, `p` is in [0, 1].
+f64 percentile(std::span<const f64> sorted, f64 p);
+
+Distribution describe(std::span<const f64> samples);
+
+// Two-sided p-value of the Mann-Whitney U test: how likely rank sums at least this far apart
+// are if `a` and `b` come from the same distribution. It compares ranks rather than values,
+// so a few stalls cannot hide or fake a shift. Uses the normal approximation with a tie
+// correction, which needs about 8 samples on each side to be reliable. Returns 1 when either
+// side is empty.
+f64 mann_whitney(std::span<const f64> a, std::span<const f64> b);
+
+// e.g. `850ns`, `12.50us`, `3.20ms` or `1.250s`
+std::string format_nanos(f64 ns);
+
+// e.g. `512B`, `1.50KiB` or `2.00MiB`
+std::string format_bytes(u64 bytes);
+
+}  // namespace aoc
@@ -4,24 +4,29 @@
 
 #include <algorithm>
 #include <cctype>
+#include <concepts>
 #include <optional>
 #include <ostream>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace aoc {
 
+// The trimming and splitting functions below are `constexpr`, so solvers can use them on
+// inputs embedded at compile time (see `AOC_EMBED_INPUTS`).
+
 // https://stackoverflow.com/a/67664561
 template<typename T>
-std::string_view trim_left(const T& s) {
+constexpr std::string_view trim_left(const T& s) {
     std::string_view sv{s};
     sv.remove_prefix(std::min(sv.find_first_not_of(" \t\n\r\f\v"), sv.size()));
     return sv;
 }
 
 template<typename T>
-std::string_view trim_right(const T& s) {
+constexpr std::string_view trim_right(const T& s) {
     std::string_view sv{s};
     auto trim_pos = sv.find_last_not_of(" \t\n\r\f\v");
     if (trim_pos == std::string_view::npos) {
@@ -32,7 +37,7 @@ std::string_view trim_right(const T& s) {
 }
 
 template<typename T>
-std::string_view trim(const T& s) {
+constexpr std::string_view trim(const T& s) {
     auto sv = trim_left(s);
     sv = trim_right(sv);
     return sv;
@@ -64,14 +69,20 @@ enum class SplitOptions {
     Trim = 1 << 1,
 };
 
-SplitOptions operator|(SplitOptions lhs, SplitOptions rhs);
+constexpr SplitOptions operator|(SplitOptions lhs, SplitOptions rhs) {
+    using Ty = std::underlying_type_t<SplitOptions>;
+    return static_cast<SplitOptions>(static_cast<Ty>(lhs) | static_cast<Ty>(rhs));
+}
 
-SplitOptions operator&(SplitOptions lhs, SplitOptions rhs);
+constexpr SplitOptions operator&(SplitOptions lhs, SplitOptions rhs) {
+    using Ty = std::underlying_type_t<SplitOptions>;
+    return static_cast<SplitOptions>(static_cast<Ty>(lhs) & static_cast<Ty>(rhs));
+}
 
 std::ostream& operator<<(std::ostream& os, const SplitOptions& opt);
 
 template<Pattern P>
-std::optional<std::pair<std::string_view, std::string_view>> split_once(
+constexpr std::optional<std::pair<std::string_view, std::string_view>> split_once(
     std::string_view s,
     P pattern
 ) {
@@ -95,7 +106,11 @@ std::optional<std::pair<std::string_view, std::string_view>> split_once(
 }
 
 template<Pattern P>
-std::vector<std::string_view> split(std::string_view s, P pattern, SplitOptions opts = {}) {
+constexpr std::vector<std::string_view> split(
+    std::string_view s,
+    P pattern,
+    SplitOptions opts = {}
+) {
     std::vector<std::string_view> result{};
 
     std::string_view buf{s};
@@ -127,6 +142,35 @@ std::vector<std::string_view> split(std::string_view s, P pattern, SplitOptions
     return result;
 }
 
+// Parses a decimal integer with an optional leading `-` (for signed types), which must span
+// all of `s`. Unlike `std::stoll` and `std::from_chars`, it can run at compile time. Values
+// that do not fit in `T` are not detected.
+template<std::integral T>
+constexpr std::optional<T> parse_int(std::string_view s) {
+    bool negative{};
+    if constexpr (std::signed_integral<T>) {
+        if (s.starts_with('-')) {
+            negative = true;
+            s.remove_prefix(1);
+        }
+    }
+    if (s.empty()) {
+        return {};
+    }
+
+    T value{};
+    for (auto c : s) {
+        if (c < '0' || c > '9') {
+            return {};
+        }
+        // negative values accumulate below zero, so the minimum of `T` parses too
+        auto digit = static_cast<T>(c - '0');
+        value = static_cast<T>(value * 10);
+        value = static_cast<T>(negative ? value - digit : value + digit);
+    }
+    return value;
+}
+
 inline bool is_word_char(char c) {
     return static_cast<bool>(std::isalnum(c)) || c == '_';
 }
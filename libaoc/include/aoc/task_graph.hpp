@@ -0,0 +1,76 @@
+#pragma once
+
+#include "aoc/thread_pool.hpp"
+#include "aoc/types.hpp"
+
+#include <functional>
+#include <initializer_list>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Small dependency graph of tasks that runs on a `ThreadPool`, e.g. parsing an input once and
+// then solving both parts from it at the same time:
+//
+//     aoc::TaskGraph graph{};
+//     auto parse = graph.add([&] { input = parse(path); });
+//     graph.add([&] { p1 = part1(input); }, {parse});
+//     graph.add([&] { p2 = part2(input); }, {parse});
+//     graph.run();
+//
+// A task can only depend on tasks added before it, so the graph has no cycles. Tasks are
+// grouped into waves by their longest chain of dependencies: the tasks of a wave run
+// concurrently, after every task of the previous wave finished. That is exact for the
+// fork/join shapes used here, and never runs a task before its dependencies.
+class TaskGraph {
+public:
+    using TaskId = usize;
+
+    TaskId add(std::function<void()> task, std::initializer_list<TaskId> deps = {});
+
+    [[nodiscard]]
+    usize size() const {
+        return _tasks.size();
+    }
+
+    // Runs every task once. The first exception thrown by a task is rethrown once its wave
+    // finished, and the waves after it are skipped.
+    void run(ThreadPool& pool = ThreadPool::global()) const;
+
+private:
+    struct Task {
+        std::function<void()> fn{};
+        usize wave{};
+    };
+
+    std::vector<Task> _tasks{};
+    usize _waves{};
+};
+
+// Calls `parse()` once, then `part1` and `part2` on its result at the same time, and returns
+// both answers as a pair. The parts only read the parsed input, so they need no locking, and
+// solving takes as long as the slower part instead of both. `parse` may also return a
+// reference to an input that was parsed earlier.
+template<typename Parse, typename Part1, typename Part2>
+auto solve_concurrently(
+    Parse&& parse,
+    Part1&& part1,
+    Part2&& part2,
+    ThreadPool& pool = ThreadPool::global()
+) {
+    decltype(auto) parsed = std::invoke(std::forward<Parse>(parse));
+    const auto& input = parsed;
+    std::optional<std::remove_cvref_t<std::invoke_result_t<Part1&, decltype(input)>>> p1{};
+    std::optional<std::remove_cvref_t<std::invoke_result_t<Part2&, decltype(input)>>> p2{};
+
+    TaskGraph graph{};
+    graph.add([&] { p1.emplace(std::invoke(part1, input)); });
+    graph.add([&] { p2.emplace(std::invoke(part2, input)); });
+    graph.run(pool);
+    return std::pair{std::move(*p1), std::move(*p2)};
+}
+
+}  // namespace aoc
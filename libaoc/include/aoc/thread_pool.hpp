@@ -0,0 +1,193 @@
+#pragma once
+
+#include "aoc/types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Fixed set of worker threads shared by the parallel algorithms below. Each worker owns a
+// deque of tasks: it pops its own work from the back, while idle workers steal from the
+// front of the others', so unevenly sized chunks still keep every thread busy.
+//
+// A pool of `n` threads starts `n - 1` workers, since the thread waiting on a batch runs
+// tasks as well. This makes nested parallel calls from inside a task safe, and a pool of one
+// thread runs everything inline.
+class ThreadPool {
+public:
+    // 0 uses every hardware thread
+    explicit ThreadPool(usize threads = 0);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+    ~ThreadPool();
+
+    // number of threads that run tasks, including the waiting one
+    [[nodiscard]]
+    usize size() const {
+        return _workers.size() + 1;
+    }
+
+    // Runs `task(i)` for each `i` in [0, count) and returns once all of them finished. The
+    // first exception thrown by a task is rethrown here, after the others completed.
+    void run(usize count, const std::function<void(usize)>& task);
+
+    // Pool used by the parallel algorithms unless they are given one, created on first use.
+    static ThreadPool& global();
+    // Sets the size of the global pool, must be called before its first use.
+    static void set_global_threads(usize threads);
+
+private:
+    struct Batch;
+
+    struct Task {
+        const std::function<void(usize)>* fn{};
+        usize index{};
+        Batch* batch{};
+    };
+
+    struct Queue {
+        std::mutex mutex{};
+        std::deque<Task> tasks{};
+    };
+
+    [[nodiscard]]
+    usize worker_index() const;
+    bool try_run_one(usize self);
+    void work(usize index);
+
+    std::vector<std::unique_ptr<Queue>> _queues{};
+    std::mutex _mutex{};
+    std::condition_variable _wake{};
+    // tasks pushed but not yet taken, guarded by `_mutex` when it goes up
+    std::atomic<usize> _queued{};
+    std::atomic<usize> _next_queue{};
+    bool _stop{};
+    std::vector<std::jthread> _workers{};
+};
+
+namespace details {
+    // `grain` indices per chunk, or about four chunks per thread for 0
+    constexpr usize chunk_size(usize count, usize grain, usize threads) {
+        if (grain > 0) {
+            return grain;
+        }
+        return std::max(count / (threads * 4), usize{1});
+    }
+
+    // result of one chunk of `parallel_reduce`. each is on its own cache line, so workers
+    // storing neighbouring results do not contend for it (or, for `bool`, race on the packed
+    // words of a `std::vector<bool>`)
+    template<typename T>
+    struct alignas(CACHE_LINE) Slot {
+        T value;
+    };
+}  // namespace details
+
+// Calls `fn(i)` for every `i` in [begin, end), in chunks of `grain` indices.
+template<typename F>
+void parallel_for(
+    usize begin,
+    usize end,
+    F&& fn,
+    usize grain = 0,
+    ThreadPool& pool = ThreadPool::global()
+) {
+    if (begin >= end) {
+        return;
+    }
+    auto size = details::chunk_size(end - begin, grain, pool.size());
+    auto chunks = (end - begin + size - 1) / size;
+
+    pool.run(chunks, [&](usize c) {
+        auto lo = begin + c * size;
+        auto hi = std::min(lo + size, end);
+        for (auto i = lo; i < hi; ++i) {
+            fn(i);
+        }
+    });
+}
+
+// Combines `map(i)` for every `i` in [begin, end) with `reduce`, where `identity` is the
+// neutral value of `reduce` (e.g. 0 for a sum). Chunk results are combined in index order,
+// so `reduce` has to be associative but not commutative.
+template<typename T, typename Map, typename Reduce>
+T parallel_reduce(
+    usize begin,
+    usize end,
+    T identity,
+    Map&& map,
+    Reduce&& reduce,
+    usize grain = 0,
+    ThreadPool& pool = ThreadPool::global()
+) {
+    if (begin >= end) {
+        return identity;
+    }
+    auto size = details::chunk_size(end - begin, grain, pool.size());
+    auto chunks = (end - begin + size - 1) / size;
+
+    std::vector<details::Slot<T>> partial(chunks, details::Slot<T>{identity});
+    pool.run(chunks, [&](usize c) {
+        auto lo = begin + c * size;
+        auto hi = std::min(lo + size, end);
+        T acc = identity;
+        for (auto i = lo; i < hi; ++i) {
+            acc = reduce(std::move(acc), map(i));
+        }
+        partial[c].value = std::move(acc);
+    });
+
+    T result = std::move(identity);
+    for (auto& p : partial) {
+        result = reduce(std::move(result), std::move(p.value));
+    }
+    return result;
+}
+
+// Sorts chunks of `grain` elements in parallel, then merges neighbouring runs pairwise until
+// one is left. Like `std::sort`, it is not stable.
+template<std::ranges::random_access_range R, typename Compare = std::ranges::less>
+void parallel_sort(
+    R&& range,
+    Compare comp = {},
+    usize grain = 0,
+    ThreadPool& pool = ThreadPool::global()
+) {
+    auto first = std::ranges::begin(range);
+    auto n = static_cast<usize>(std::ranges::distance(range));
+    auto size = details::chunk_size(n, grain, pool.size());
+    if (size >= n) {
+        std::sort(first, first + n, comp);
+        return;
+    }
+
+    using Diff = std::ranges::range_difference_t<R>;
+    auto at = [first](usize i) { return first + static_cast<Diff>(i); };
+    pool.run((n + size - 1) / size, [&](usize c) {
+        std::sort(at(c * size), at(std::min((c + 1) * size, n)), comp);
+    });
+    for (auto width = size; width < n; width *= 2) {
+        pool.run((n + 2 * width - 1) / (2 * width), [&](usize m) {
+            auto lo = m * 2 * width;
+            auto mid = std::min(lo + width, n);
+            auto hi = std::min(lo + 2 * width, n);
+            std::inplace_merge(at(lo), at(mid), at(hi), comp);
+        });
+    }
+}
+
+}  // namespace aoc
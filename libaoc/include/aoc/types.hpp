@@ -29,13 +29,16 @@ concept StrLike = std::convertible_to<T, std::string_view>;
 namespace details {
     using size_type = std::string_view::size_type;
 
+    // data written by different threads is kept this far apart, so they do not share a line
+    constexpr usize CACHE_LINE{64};
+
     template<CharLike T>
-    size_type pattern_len(T) {
+    constexpr size_type pattern_len(T) {
         return 1;
     }
 
     template<StrLike T>
-    size_type pattern_len(const T& t) {
+    constexpr size_type pattern_len(const T& t) {
         return std::string_view(t).length();
     }
 }  // namespace details
@@ -0,0 +1,229 @@
+#include "aoc/alloc.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace aoc {
+
+namespace {
+    struct ThreadAllocs {
+        u64 count;
+        u64 bytes;
+        // can go negative when memory is freed by another thread than the one that
+        // allocated it, only differences are meaningful
+        i64 live;
+        i64 peak;
+    };
+
+    thread_local constinit ThreadAllocs thread_allocs{};
+
+    std::atomic<u64> total_count{};
+    std::atomic<u64> total_bytes{};
+    std::atomic<i64> total_live{};
+    std::atomic<i64> total_peak{};
+
+#if defined(AOC_TRACK_ALLOCS) && AOC_TRACK_ALLOCS
+    void on_alloc(usize size) {
+        auto& t = thread_allocs;
+        t.count++;
+        t.bytes += size;
+        t.live += static_cast<i64>(size);
+        t.peak = std::max(t.peak, t.live);
+
+        total_count.fetch_add(1, std::memory_order_relaxed);
+        total_bytes.fetch_add(size, std::memory_order_relaxed);
+        auto live = total_live.fetch_add(static_cast<i64>(size), std::memory_order_relaxed)
+            + static_cast<i64>(size);
+        auto peak = total_peak.load(std::memory_order_relaxed);
+        while (live > peak
+               && !total_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    }
+
+    void on_free(usize size) {
+        thread_allocs.live -= static_cast<i64>(size);
+        total_live.fetch_sub(static_cast<i64>(size), std::memory_order_relaxed);
+    }
+
+    // every block starts with a header holding the requested size, so that unsized deletes
+    // can be accounted for. the header is padded to the block alignment.
+    constexpr usize header_size(usize align) {
+        return std::max(align, usize{__STDCPP_DEFAULT_NEW_ALIGNMENT__});
+    }
+
+    void* tracked_alloc(usize size, usize align) noexcept {
+        auto offset = header_size(align);
+        void* raw{};
+        if (align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            raw = std::malloc(size + offset);  // NOLINT(*-no-malloc, *-owning-memory)
+        } else {
+            auto total = (size + offset + align - 1) / align * align;
+            raw = std::aligned_alloc(align, total);  // NOLINT(*-no-malloc, *-owning-memory)
+        }
+        if (raw == nullptr) {
+            return nullptr;
+        }
+
+        auto* ptr = static_cast<std::byte*>(raw) + offset;
+        reinterpret_cast<usize*>(ptr)[-1] = size;  // NOLINT(*-reinterpret-cast)
+        on_alloc(size);
+        return ptr;
+    }
+
+    void tracked_free(void* ptr, usize align) noexcept {
+        if (ptr == nullptr) {
+            return;
+        }
+
+        auto* p = static_cast<std::byte*>(ptr);
+        on_free(reinterpret_cast<usize*>(p)[-1]);  // NOLINT(*-reinterpret-cast)
+        std::free(p - header_size(align));  // NOLINT(*-no-malloc, *-owning-memory)
+    }
+
+    void* tracked_new(usize size, usize align) {
+        while (true) {
+            if (auto* ptr = tracked_alloc(size, align)) {
+                return ptr;
+            }
+            auto handler = std::get_new_handler();
+            if (handler == nullptr) {
+                throw std::bad_alloc{};
+            }
+            handler();
+        }
+    }
+#endif
+}  // namespace
+
+bool alloc_tracking_enabled() {
+#if defined(AOC_TRACK_ALLOCS) && AOC_TRACK_ALLOCS
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocMark alloc_begin() {
+    auto& t = thread_allocs;
+    AllocMark mark{t.count, t.bytes, t.live, t.peak};
+    t.peak = t.live;
+    return mark;
+}
+
+AllocStats alloc_end(const AllocMark& mark) {
+    auto& t = thread_allocs;
+    AllocStats stats{
+        t.count - mark.count,
+        t.bytes - mark.bytes,
+        static_cast<u64>(std::max(t.peak - mark.live, i64{})),
+    };
+
+    // the enclosing phase keeps whichever peak is higher, its own or this one
+    t.peak = std::max(t.peak, mark.outer_peak);
+    return stats;
+}
+
+AllocStats alloc_totals() {
+    return {
+        total_count.load(std::memory_order_relaxed),
+        total_bytes.load(std::memory_order_relaxed),
+        static_cast<u64>(std::max(total_peak.load(std::memory_order_relaxed), i64{})),
+    };
+}
+
+}  // namespace aoc
+
+#if defined(AOC_TRACK_ALLOCS) && AOC_TRACK_ALLOCS
+
+// NOLINTBEGIN(*-new-delete-overloads)
+namespace {
+constexpr aoc::usize DEFAULT_ALIGN = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+constexpr aoc::usize to_usize(std::align_val_t align) {
+    return static_cast<aoc::usize>(align);
+}
+}  // namespace
+
+void* operator new(std::size_t size) {
+    return aoc::tracked_new(size, DEFAULT_ALIGN);
+}
+
+void* operator new[](std::size_t size) {
+    return aoc::tracked_new(size, DEFAULT_ALIGN);
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    return aoc::tracked_new(size, to_usize(align));
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return aoc::tracked_new(size, to_usize(align));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return aoc::tracked_alloc(size, DEFAULT_ALIGN);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return aoc::tracked_alloc(size, DEFAULT_ALIGN);
+}
+
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return aoc::tracked_alloc(size, to_usize(align));
+}
+
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return aoc::tracked_alloc(size, to_usize(align));
+}
+
+void operator delete(void* ptr) noexcept {
+    aoc::tracked_free(ptr, DEFAULT_ALIGN);
+}
+
+void operator delete[](void* ptr) noexcept {
+    aoc::tracked_free(ptr, DEFAULT_ALIGN);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    aoc::tracked_free(ptr, DEFAULT_ALIGN);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    aoc::tracked_free(ptr, DEFAULT_ALIGN);
+}
+
+void operator delete(void* ptr, std::align_val_t align) noexcept {
+    aoc::tracked_free(ptr, to_usize(align));
+}
+
+void operator delete[](void* ptr, std::align_val_t align) noexcept {
+    aoc::tracked_free(ptr, to_usize(align));
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t align) noexcept {
+    aoc::tracked_free(ptr, to_usize(align));
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t align) noexcept {
+    aoc::tracked_free(ptr, to_usize(align));
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    aoc::tracked_free(ptr, DEFAULT_ALIGN);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    aoc::tracked_free(ptr, DEFAULT_ALIGN);
+}
+
+void operator delete(void* ptr, std::align_val_t align, const std::nothrow_t&) noexcept {
+    aoc::tracked_free(ptr, to_usize(align));
+}
+
+void operator delete[](void* ptr, std::align_val_t align, const std::nothrow_t&) noexcept {
+    aoc::tracked_free(ptr, to_usize(align));
+}
+// NOLINTEND(*-new-delete-overloads)
+
+#endif
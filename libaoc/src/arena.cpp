@@ -0,0 +1,127 @@
+#include "aoc/arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#if defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
+namespace aoc {
+
+namespace {
+    constexpr usize HUGE_PAGE{usize{2} << 20};
+
+    constexpr usize round_up(usize n, usize multiple) {
+        return (n + multiple - 1) / multiple * multiple;
+    }
+}  // namespace
+
+Arena::Arena(ArenaOptions opts)
+    : _opts{opts},
+      _next_size{std::clamp(opts.block_size, usize{64}, MAX_BLOCK)} {}
+
+Arena::~Arena() {
+    for (const auto& block : _blocks) {
+        free_block(block);
+    }
+}
+
+void Arena::reset() {
+    if (_blocks.empty()) {
+        return;
+    }
+
+    // replaces several blocks by one of their total size, so a run like the last one fits in
+    // it without allocating again
+    if (_blocks.size() > 1) {
+        auto total = reserved();
+        for (const auto& block : _blocks) {
+            free_block(block);
+        }
+        // emptied before allocating, so if that throws the destructor does not free the old
+        // blocks again
+        _blocks.clear();
+        _cursor = nullptr;
+        _end = nullptr;
+        _used = 0;
+        _blocks.push_back(allocate_block(total));
+        _next_size = std::min(total * 2, MAX_BLOCK);
+    }
+
+    const auto& block = _blocks.front();
+    _cursor = block.data;
+    _end = block.data + block.size;
+    _used = 0;
+}
+
+usize Arena::reserved() const {
+    usize total{};
+    for (const auto& block : _blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+bool Arena::huge_pages() const {
+    return std::ranges::any_of(_blocks, &Block::mapped);
+}
+
+void* Arena::do_allocate(usize bytes, usize alignment) {
+    auto align_cursor = [this, alignment] {
+        auto addr = reinterpret_cast<std::uintptr_t>(_cursor);  // NOLINT(*-reinterpret-cast)
+        return _cursor + (round_up(addr, alignment) - addr);
+    };
+
+    auto* ptr = align_cursor();
+    if (_cursor == nullptr || bytes > static_cast<usize>(_end - ptr)) {
+        // the padding needed to align the start of a fresh block is at most `alignment`
+        grow(bytes + alignment);
+        ptr = align_cursor();
+    }
+
+    _used += static_cast<usize>(ptr - _cursor) + bytes;
+    _cursor = ptr + bytes;
+    return ptr;
+}
+
+void Arena::grow(usize min_size) {
+    auto size = std::max(_next_size, min_size);
+    if (_opts.huge_pages) {
+        size = round_up(size, HUGE_PAGE);
+    }
+
+    auto block = allocate_block(size);
+    _blocks.push_back(block);
+    _cursor = block.data;
+    _end = block.data + block.size;
+    _next_size = std::min(std::max(_next_size, size) * 2, MAX_BLOCK);
+}
+
+Arena::Block Arena::allocate_block(usize size) const {
+#if defined(__linux__)
+    if (_opts.huge_pages) {
+        auto* mem =
+            mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem != MAP_FAILED) {
+            // only advice, the kernel may still back the block with regular pages
+            madvise(mem, size, MADV_HUGEPAGE);
+            return {static_cast<std::byte*>(mem), size, true};
+        }
+    }
+#endif
+    return {static_cast<std::byte*>(::operator new(size)), size, false};
+}
+
+void Arena::free_block(const Block& block) {
+#if defined(__linux__)
+    if (block.mapped) {
+        munmap(block.data, block.size);
+        return;
+    }
+#endif
+    ::operator delete(block.data);
+}
+
+}  // namespace aoc
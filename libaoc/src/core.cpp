@@ -0,0 +1,19 @@
+#include "aoc/core.hpp"
+
+#include <atomic>
+
+namespace aoc {
+
+namespace {
+    std::atomic<bool> throw_on_panic{};
+}  // namespace
+
+void set_panics_throw(bool enabled) {
+    throw_on_panic.store(enabled);
+}
+
+bool panics_throw() {
+    return throw_on_panic.load();
+}
+
+}  // namespace aoc
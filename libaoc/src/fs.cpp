@@ -1,14 +1,76 @@
 #include "aoc/fs.hpp"
 
+#include "aoc/perf.hpp"
+
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
 namespace aoc {
 
+namespace {
+    struct InputFiles {
+        std::mutex mutex{};
+        std::unordered_map<std::string, usize> sizes{};
+    };
+
+    // leaked on purpose, so it is still alive for reports printed by exit handlers
+    InputFiles& input_files() {
+        static auto* files = new InputFiles{};  // NOLINT(cppcoreguidelines-owning-memory)
+        return *files;
+    }
+
+    void record_input(const std::filesystem::path& path) {
+        std::error_code ec{};
+        auto canonical = std::filesystem::weakly_canonical(path, ec);
+        if (ec) {
+            return;
+        }
+        auto size = std::filesystem::file_size(path, ec);
+        if (ec) {
+            return;
+        }
+
+        auto& files = input_files();
+        std::scoped_lock lock{files.mutex};
+        files.sizes[canonical.string()] = static_cast<usize>(size);
+    }
+}  // namespace
+
 std::fstream open(const std::filesystem::path& path) {
     std::fstream input{path};
     if (!input) {
         throw std::runtime_error{"Failed to read file"};
     }
+    // only the counter report divides by it, so other runs (e.g. a server opening new
+    // files for as long as it runs) skip the lookups and keep the table empty
+    if (PerfCounters::enabled()) {
+        record_input(path);
+    }
 
     return input;
 }
 
+Generator<std::string> read_lines(std::filesystem::path path) {
+    auto input = open(path);
+    std::string line{};
+    while (std::getline(input, line)) {
+        co_yield line;
+    }
+}
+
+usize input_bytes() {
+    auto& files = input_files();
+    std::scoped_lock lock{files.mutex};
+    return std::transform_reduce(
+        files.sizes.begin(),
+        files.sizes.end(),
+        usize{},
+        std::plus<>(),
+        [](const auto& entry) { return entry.second; }
+    );
+}
+
 }  // namespace aoc
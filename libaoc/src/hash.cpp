@@ -0,0 +1,85 @@
+#include "aoc/hash.hpp"
+
+#include <bit>
+
+namespace aoc {
+
+namespace {
+    constexpr u64 PRIME1{0x9E3779B185EBCA87};
+    constexpr u64 PRIME2{0xC2B2AE3D27D4EB4F};
+    constexpr u64 PRIME3{0x165667B19E3779F9};
+    constexpr u64 PRIME4{0x85EBCA77C2B2AE63};
+    constexpr u64 PRIME5{0x27D4EB2F165667C5};
+
+    // the spec reads words as little endian, compilers turn this into one load on such targets
+    template<typename T>
+    T read_le(const char* p) {
+        T value{};
+        for (usize i = 0; i < sizeof(T); ++i) {
+            value |= static_cast<T>(static_cast<u8>(p[i])) << (8 * i);
+        }
+        return value;
+    }
+
+    u64 round(u64 acc, u64 lane) {
+        acc += lane * PRIME2;
+        return std::rotl(acc, 31) * PRIME1;
+    }
+
+    u64 merge_round(u64 acc, u64 lane) {
+        acc ^= round(0, lane);
+        return acc * PRIME1 + PRIME4;
+    }
+}  // namespace
+
+u64 xxh64(std::string_view data, u64 seed) {
+    const char* p = data.data();
+    const char* end = p + data.size();
+    u64 acc{};
+
+    if (data.size() >= 32) {
+        // four lanes over 32-byte stripes
+        u64 v1 = seed + PRIME1 + PRIME2;
+        u64 v2 = seed + PRIME2;
+        u64 v3 = seed;
+        u64 v4 = seed - PRIME1;
+        for (; end - p >= 32; p += 32) {
+            v1 = round(v1, read_le<u64>(p));
+            v2 = round(v2, read_le<u64>(p + 8));
+            v3 = round(v3, read_le<u64>(p + 16));
+            v4 = round(v4, read_le<u64>(p + 24));
+        }
+        acc = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+        acc = merge_round(acc, v1);
+        acc = merge_round(acc, v2);
+        acc = merge_round(acc, v3);
+        acc = merge_round(acc, v4);
+    } else {
+        acc = seed + PRIME5;
+    }
+    acc += data.size();
+
+    for (; end - p >= 8; p += 8) {
+        acc ^= round(0, read_le<u64>(p));
+        acc = std::rotl(acc, 27) * PRIME1 + PRIME4;
+    }
+    if (end - p >= 4) {
+        acc ^= static_cast<u64>(read_le<u32>(p)) * PRIME1;
+        acc = std::rotl(acc, 23) * PRIME2 + PRIME3;
+        p += 4;
+    }
+    for (; p != end; ++p) {
+        acc ^= static_cast<u64>(static_cast<u8>(*p)) * PRIME5;
+        acc = std::rotl(acc, 11) * PRIME1;
+    }
+
+    // avalanche
+    acc ^= acc >> 33;
+    acc *= PRIME2;
+    acc ^= acc >> 29;
+    acc *= PRIME3;
+    acc ^= acc >> 32;
+    return acc;
+}
+
+}  // namespace aoc
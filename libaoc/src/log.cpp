@@ -0,0 +1,54 @@
+#include "aoc/log.hpp"
+
+#include <spdlog/async.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace aoc {
+
+void use_async_logger(usize queue_size) {
+    if (queue_size == 0) {
+        queue_size = DEFAULT_LOG_QUEUE_SIZE;
+    }
+
+    spdlog::init_thread_pool(queue_size, 1);
+    auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    auto logger = std::make_shared<spdlog::async_logger>(
+        "",
+        std::move(sink),
+        spdlog::thread_pool(),
+        spdlog::async_overflow_policy::overrun_oldest
+    );
+    logger->set_level(spdlog::get_level());
+    spdlog::set_default_logger(std::move(logger));
+
+    static bool registered{};
+    if (!registered) {
+        registered = true;
+        std::atexit([]() { spdlog::shutdown(); });
+    }
+}
+
+void init_logging(spdlog::level::level_enum level) {
+    spdlog::set_level(level);
+
+    // NOLINTNEXTLINE(concurrency-mt-unsafe): only read during startup
+    const char* async = std::getenv("AOC_LOG_ASYNC");
+    if (async == nullptr) {
+        return;
+    }
+
+    usize queue_size{};
+    try {
+        queue_size = std::stoull(std::string{async});
+    } catch (const std::exception&) {
+        queue_size = DEFAULT_LOG_QUEUE_SIZE;
+    }
+    use_async_logger(queue_size);
+}
+
+}  // namespace aoc
@@ -0,0 +1,192 @@
+#include "aoc/perf.hpp"
+
+#include "aoc/core.hpp"
+
+#include <cstdlib>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+#if defined(__linux__)
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace aoc {
+
+namespace {
+#if defined(__linux__)
+    // order matches the fields of `PerfSample`, the first event leads the group
+    constexpr std::array<u64, 4> EVENTS{
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,
+    };
+
+    int open_event(u64 config, int group_fd) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = group_fd == -1 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_ENABLED
+            | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // NOLINTNEXTLINE(*-vararg): no glibc wrapper for this syscall
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+    }
+
+    u64 event_id(int fd) {
+        u64 id{};
+        // NOLINTNEXTLINE(*-vararg)
+        if (ioctl(fd, PERF_EVENT_IOC_ID, &id) == -1) {
+            return 0;
+        }
+        return id;
+    }
+#endif
+}  // namespace
+
+PerfCounters::PerfCounters() {
+#if defined(__linux__)
+    _fds[0] = open_event(EVENTS[0], -1);
+    if (_fds[0] == -1) {
+        static std::once_flag warned{};
+        std::call_once(warned, [] {
+            spdlog::warn("Hardware performance counters are unavailable");
+        });
+        return;
+    }
+    for (usize i = 1; i < EVENT_COUNT; ++i) {
+        _fds.at(i) = open_event(EVENTS.at(i), _fds[0]);
+    }
+    for (usize i = 0; i < EVENT_COUNT; ++i) {
+        if (_fds.at(i) != -1) {
+            _ids.at(i) = event_id(_fds.at(i));
+        }
+    }
+
+    // NOLINTBEGIN(*-vararg)
+    ioctl(_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    // NOLINTEND(*-vararg)
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#if defined(__linux__)
+    for (int fd : _fds) {
+        if (fd != -1) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+bool PerfCounters::enabled() {
+    static const bool enabled = [] {
+        // NOLINTNEXTLINE(concurrency-mt-unsafe): read once
+        const char* value = std::getenv("AOC_PERF");
+        return value != nullptr && *value != '\0' && std::string_view{value} != "0";
+    }();
+    return enabled;
+}
+
+PerfCounters& PerfCounters::for_this_thread() {
+    thread_local PerfCounters counters{};
+    return counters;
+}
+
+PerfSample PerfCounters::read() const {
+    PerfSample result{};
+#if defined(__linux__)
+    if (!available()) {
+        return result;
+    }
+
+    // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, then {value, id} per event
+    struct {
+        u64 nr;
+        u64 time_enabled;
+        u64 time_running;
+        std::array<std::array<u64, 2>, EVENT_COUNT> values;
+    } data{};
+
+    if (::read(_fds[0], &data, sizeof(data)) <= 0 || data.time_running == 0) {
+        return result;
+    }
+
+    // scale up when the group only ran for part of the time it was enabled
+    auto scale = static_cast<double>(data.time_enabled) / static_cast<double>(data.time_running);
+    std::array<u64*, EVENT_COUNT> fields{
+        &result.cycles,
+        &result.instructions,
+        &result.cache_misses,
+        &result.branch_misses,
+    };
+
+    // events that failed to open are missing from the group, so match values by id
+    for (usize i = 0; i < EVENT_COUNT; ++i) {
+        if (_fds.at(i) == -1) {
+            continue;
+        }
+        for (usize j = 0; j < data.nr && j < EVENT_COUNT; ++j) {
+            if (data.values.at(j)[1] == _ids.at(i)) {
+                auto value = static_cast<double>(data.values.at(j)[0]);
+                *fields.at(i) = static_cast<u64>(value * scale);
+            }
+        }
+    }
+#endif
+    return result;
+}
+
+PerfSample PerfCounters::read_attributed() const {
+    auto sample = read();
+    sample += _delegated;
+    return sample - _lent;
+}
+
+PerfHandoff::Scope::Scope(PerfHandoff* handoff) {
+    if (handoff == nullptr || !PerfCounters::enabled()) {
+        return;
+    }
+    auto& counters = PerfCounters::for_this_thread();
+    if (counters.available()) {
+        _handoff = handoff;
+        _counters = &counters;
+        _start = counters.read_attributed();
+    }
+}
+
+PerfHandoff::Scope::~Scope() {
+    if (_counters == nullptr) {
+        return;
+    }
+    auto used = _counters->read_attributed() - _start;
+    _counters->add_lent(used);
+    std::scoped_lock lock{_handoff->_mutex};
+    _handoff->_total += used;
+}
+
+void PerfHandoff::settle() {
+    if (!PerfCounters::enabled()) {
+        return;
+    }
+    PerfSample total{};
+    {
+        std::scoped_lock lock{_mutex};
+        total = std::exchange(_total, {});
+    }
+    auto& counters = PerfCounters::for_this_thread();
+    if (counters.available()) {
+        counters.add_delegated(total);
+    }
+}
+
+}  // namespace aoc
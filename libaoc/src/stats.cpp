@@ -0,0 +1,143 @@
+#include "aoc/stats.hpp"
+
+#include "aoc/core.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+f64 percentile(std::span<const f64> sorted, f64 p) {
+    AOC_ASSERT(!sorted.empty(), "percentile of an empty sample");
+    AOC_DEBUG_ASSERT(std::ranges::is_sorted(sorted), "samples must be sorted");
+
+    auto rank = std::clamp(p, 0.0, 1.0) * static_cast<f64>(sorted.size() - 1);
+    auto lo = static_cast<usize>(std::floor(rank));
+    auto hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (rank - static_cast<f64>(lo));
+}
+
+Distribution describe(std::span<const f64> samples) {
+    Distribution result{};
+    result.samples = samples.size();
+    if (samples.empty()) {
+        return result;
+    }
+
+    std::vector<f64> sorted{samples.begin(), samples.end()};
+    std::ranges::sort(sorted);
+
+    result.min = sorted.front();
+    result.median = percentile(sorted, 0.5);
+    result.p90 = percentile(sorted, 0.9);
+    result.p99 = percentile(sorted, 0.99);
+    result.max = sorted.back();
+
+    auto q1 = percentile(sorted, 0.25);
+    auto q3 = percentile(sorted, 0.75);
+    auto lo = q1 - 1.5 * (q3 - q1);
+    auto hi = q3 + 1.5 * (q3 - q1);
+
+    f64 sum{};
+    usize kept{};
+    for (auto x : sorted) {
+        if (x >= lo && x <= hi) {
+            sum += x;
+            kept++;
+        }
+    }
+    result.outliers = sorted.size() - kept;
+    result.mean = sum / static_cast<f64>(kept);
+
+    f64 sq{};
+    for (auto x : sorted) {
+        if (x >= lo && x <= hi) {
+            sq += (x - result.mean) * (x - result.mean);
+        }
+    }
+    // sample standard deviation, zero for a single sample
+    result.stddev = kept > 1 ? std::sqrt(sq / static_cast<f64>(kept - 1)) : 0.0;
+
+    return result;
+}
+
+f64 mann_whitney(std::span<const f64> a, std::span<const f64> b) {
+    if (a.empty() || b.empty()) {
+        return 1.0;
+    }
+
+    // (value, from `a`) pairs in rank order
+    std::vector<std::pair<f64, bool>> pooled{};
+    pooled.reserve(a.size() + b.size());
+    for (auto x : a) {
+        pooled.emplace_back(x, true);
+    }
+    for (auto x : b) {
+        pooled.emplace_back(x, false);
+    }
+    std::ranges::sort(pooled);
+
+    // ties share the average of their ranks, and shrink the variance of U
+    f64 rank_sum{};
+    f64 ties{};
+    for (usize i = 0; i < pooled.size();) {
+        auto j = i;
+        while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+            j++;
+        }
+        auto rank = static_cast<f64>(i + j + 1) / 2.0;
+        for (auto k = i; k < j; ++k) {
+            if (pooled[k].second) {
+                rank_sum += rank;
+            }
+        }
+        auto t = static_cast<f64>(j - i);
+        ties += t * t * t - t;
+        i = j;
+    }
+
+    auto n1 = static_cast<f64>(a.size());
+    auto n2 = static_cast<f64>(b.size());
+    auto n = n1 + n2;
+    auto u = rank_sum - n1 * (n1 + 1) / 2.0;
+    auto mean = n1 * n2 / 2.0;
+    auto variance = n1 * n2 / 12.0 * ((n + 1) - ties / (n * (n - 1)));
+    if (variance <= 0.0) {
+        return 1.0;
+    }
+
+    // continuity correction towards the mean, since U only takes discrete values
+    auto z = std::max(std::abs(u - mean) - 0.5, 0.0) / std::sqrt(variance);
+    return std::erfc(z / std::sqrt(2.0));
+}
+
+std::string format_nanos(f64 ns) {
+    if (ns < 1e3) {
+        return fmt::format("{:.0f}ns", ns);
+    }
+    if (ns < 1e6) {
+        return fmt::format("{:.2f}us", ns / 1e3);
+    }
+    if (ns < 1e9) {
+        return fmt::format("{:.2f}ms", ns / 1e6);
+    }
+    return fmt::format("{:.3f}s", ns / 1e9);
+}
+
+std::string format_bytes(u64 bytes) {
+    auto b = static_cast<f64>(bytes);
+    if (b < 1024.0) {
+        return fmt::format("{}B", bytes);
+    }
+    if (b < 1024.0 * 1024.0) {
+        return fmt::format("{:.2f}KiB", b / 1024.0);
+    }
+    if (b < 1024.0 * 1024.0 * 1024.0) {
+        return fmt::format("{:.2f}MiB", b / (1024.0 * 1024.0));
+    }
+    return fmt::format("{:.2f}GiB", b / (1024.0 * 1024.0 * 1024.0));
+}
+
+}  // namespace aoc
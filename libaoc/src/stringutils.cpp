@@ -30,14 +30,4 @@ std::string to_upper_copy(std::string_view sv) {
     return result;
 }
 
-SplitOptions operator|(SplitOptions lhs, SplitOptions rhs) {
-    using Ty = std::underlying_type_t<SplitOptions>;
-    return static_cast<SplitOptions>(static_cast<Ty>(lhs) | static_cast<Ty>(rhs));
-}
-
-SplitOptions operator&(SplitOptions lhs, SplitOptions rhs) {
-    using Ty = std::underlying_type_t<SplitOptions>;
-    return static_cast<SplitOptions>(static_cast<Ty>(lhs) & static_cast<Ty>(rhs));
-}
-
 }  // namespace aoc
@@ -0,0 +1,33 @@
+#include "aoc/task_graph.hpp"
+
+#include "aoc/core.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace aoc {
+
+TaskGraph::TaskId TaskGraph::add(std::function<void()> task, std::initializer_list<TaskId> deps) {
+    usize wave{};
+    for (auto dep : deps) {
+        AOC_ASSERTF(dep < _tasks.size(), "Task {} depends on unknown task {}", _tasks.size(), dep);
+        wave = std::max(wave, _tasks[dep].wave + 1);
+    }
+
+    _tasks.push_back({std::move(task), wave});
+    _waves = std::max(_waves, wave + 1);
+    return _tasks.size() - 1;
+}
+
+void TaskGraph::run(ThreadPool& pool) const {
+    std::vector<std::vector<TaskId>> waves(_waves);
+    for (TaskId id = 0; id < _tasks.size(); ++id) {
+        waves[_tasks[id].wave].push_back(id);
+    }
+
+    for (const auto& wave : waves) {
+        pool.run(wave.size(), [this, &wave](usize i) { _tasks[wave[i]].fn(); });
+    }
+}
+
+}  // namespace aoc
@@ -0,0 +1,176 @@
+#include "aoc/thread_pool.hpp"
+
+#include "aoc/core.hpp"
+
+#include <limits>
+#include <optional>
+
+namespace aoc {
+
+namespace {
+    constexpr usize NOT_A_WORKER = std::numeric_limits<usize>::max();
+
+    // lets `run` tell whether it was called from one of the pool's own workers
+    thread_local const ThreadPool* current_pool{};
+    thread_local usize current_worker{NOT_A_WORKER};
+
+    std::atomic<usize> global_threads{};
+    std::atomic<bool> global_created{};
+}  // namespace
+
+struct ThreadPool::Batch {
+    std::atomic<usize> remaining{};
+    // guards `error` and `done`
+    std::mutex mutex{};
+    std::condition_variable finished{};
+    std::exception_ptr error{};
+    // set by the last task, the caller waits for this rather than `remaining` so the batch
+    // outlives that task's notification
+    bool done{};
+    // hardware counters of the tasks belong to the caller's phase, whichever thread ran them.
+    // this includes the caller's own tasks, which may run inside a nested batch's phase
+    PerfHandoff perf{};
+};
+
+ThreadPool::ThreadPool(usize threads) {
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    for (usize i = 0; i + 1 < threads; ++i) {
+        _queues.push_back(std::make_unique<Queue>());
+    }
+    for (usize i = 0; i + 1 < threads; ++i) {
+        _workers.emplace_back([this, i] { work(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{_mutex};
+        _stop = true;
+    }
+    _wake.notify_all();
+    _workers.clear();
+}
+
+void ThreadPool::run(usize count, const std::function<void(usize)>& task) {
+    if (_workers.empty() || count == 1) {
+        for (usize i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+    if (count == 0) {
+        return;
+    }
+
+    Batch batch{};
+    batch.remaining = count;
+    auto self = worker_index();
+
+    {
+        std::lock_guard lock{_mutex};
+        _queued += count;
+    }
+    for (usize i = 0; i < count; ++i) {
+        // a worker keeps its own batch local, other callers spread it over every queue
+        auto q = self != NOT_A_WORKER ? self : _next_queue.fetch_add(1) % _queues.size();
+        std::lock_guard lock{_queues[q]->mutex};
+        _queues[q]->tasks.push_back({&task, i, &batch});
+    }
+    _wake.notify_all();
+
+    // help out while there is anything to steal, which also runs tasks of nested batches.
+    // once the queues are empty, the rest of the batch is running on other threads, so
+    // sleep until the last of them finishes
+    while (batch.remaining.load(std::memory_order_acquire) > 0) {
+        if (!try_run_one(self)) {
+            break;
+        }
+    }
+    std::unique_lock lock{batch.mutex};
+    batch.finished.wait(lock, [&batch] { return batch.done; });
+    batch.perf.settle();
+    if (batch.error) {
+        std::rethrow_exception(batch.error);
+    }
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool{(global_created = true, global_threads.load())};
+    return pool;
+}
+
+void ThreadPool::set_global_threads(usize threads) {
+    AOC_ASSERT(!global_created, "the global thread pool is already running");
+    global_threads = threads;
+}
+
+usize ThreadPool::worker_index() const {
+    return current_pool == this ? current_worker : NOT_A_WORKER;
+}
+
+bool ThreadPool::try_run_one(usize self) {
+    std::optional<Task> task{};
+
+    if (self != NOT_A_WORKER) {
+        auto& own = *_queues[self];
+        std::lock_guard lock{own.mutex};
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+        }
+    }
+    // steal the oldest task of the next busy queue, starting after our own
+    auto start = self == NOT_A_WORKER ? 0 : self + 1;
+    for (usize k = 0; !task.has_value() && k < _queues.size(); ++k) {
+        auto& other = *_queues[(start + k) % _queues.size()];
+        std::lock_guard lock{other.mutex};
+        if (!other.tasks.empty()) {
+            task = other.tasks.front();
+            other.tasks.pop_front();
+        }
+    }
+    if (!task.has_value()) {
+        return false;
+    }
+    _queued.fetch_sub(1);
+
+    auto* batch = task->batch;
+    try {
+        PerfHandoff::Scope counted{&batch->perf};
+        (*task->fn)(task->index);
+    } catch (...) {
+        std::lock_guard lock{batch->mutex};
+        if (!batch->error) {
+            batch->error = std::current_exception();
+        }
+    }
+    if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // notified under the lock, since the caller destroys the batch once it sees `done`
+        std::lock_guard lock{batch->mutex};
+        batch->done = true;
+        batch->finished.notify_all();
+    }
+    return true;
+}
+
+void ThreadPool::work(usize index) {
+    current_pool = this;
+    current_worker = index;
+    PhaseRegistry::instance().set_thread_name(fmt::format("pool {}", index));
+
+    while (true) {
+        if (try_run_one(index)) {
+            continue;
+        }
+        std::unique_lock lock{_mutex};
+        _wake.wait(lock, [this] { return _stop || _queued > 0; });
+        if (_stop && _queued == 0) {
+            return;
+        }
+    }
+}
+
+}  // namespace aoc
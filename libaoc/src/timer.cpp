@@ -0,0 +1,448 @@
+#include "aoc/core.hpp"
+
+#include "aoc/fs.hpp"
+#include "aoc/stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+namespace aoc {
+
+namespace {
+    using Nanos = std::chrono::duration<double, std::nano>;
+
+    std::string format_duration(Clock::duration d) {
+        return format_nanos(std::chrono::duration_cast<Nanos>(d).count());
+    }
+
+    std::string format_count(double n) {
+        if (n < 1e3) {
+            return fmt::format("{:.0f}", n);
+        }
+        if (n < 1e6) {
+            return fmt::format("{:.2f}k", n / 1e3);
+        }
+        if (n < 1e9) {
+            return fmt::format("{:.2f}M", n / 1e6);
+        }
+        return fmt::format("{:.2f}G", n / 1e9);
+    }
+
+    i64 to_nanos(Clock::duration d) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    }
+
+    std::string escape_json(std::string_view s) {
+        std::string result{};
+        result.reserve(s.size());
+        for (char c : s) {
+            if (c == '"' || c == '\\') {
+                result.push_back('\\');
+            }
+            result.push_back(c);
+        }
+        return result;
+    }
+
+    // input bytes behind a phase's counters, the process-wide total for every call of phases
+    // that did not give their own input size
+    u64 counted_bytes(const PhaseStats& phase) {
+        if (phase.input_bytes > 0) {
+            return phase.input_bytes;
+        }
+        return static_cast<u64>(input_bytes()) * phase.counted_calls;
+    }
+
+    void print_counters(std::FILE* out, const std::vector<PhaseStats>& phases, usize width) {
+        if (std::ranges::none_of(phases, [](const auto& p) { return p.counted_calls > 0; })) {
+            return;
+        }
+
+        fmt::print(
+            out,
+            "\n{:<{}}  {:>10}  {:>10}  {:>10}  {:>6}  {:>10}  {:>10}  {:>10}  {:>10}\n",
+            "phase",
+            width,
+            "input",
+            "cycles",
+            "instr",
+            "IPC",
+            "cache-miss",
+            "br-miss",
+            "cmiss/B",
+            "brmiss/B"
+        );
+        for (const auto& phase : phases) {
+            if (phase.counted_calls == 0) {
+                continue;
+            }
+            const auto& c = phase.counters;
+            // misses are per byte of input so days with different input sizes can be compared
+            auto bytes = static_cast<double>(std::max(counted_bytes(phase), u64{1}));
+            fmt::print(
+                out,
+                "{:<{}}  {:>10}  {:>10}  {:>10}  {:>6.2f}  {:>10}  {:>10}  {:>10.4f}  {:>10.4f}\n",
+                phase.name,
+                width,
+                format_bytes(counted_bytes(phase) / phase.counted_calls),
+                format_count(static_cast<double>(c.cycles)),
+                format_count(static_cast<double>(c.instructions)),
+                c.ipc(),
+                format_count(static_cast<double>(c.cache_misses)),
+                format_count(static_cast<double>(c.branch_misses)),
+                static_cast<double>(c.cache_misses) / bytes,
+                static_cast<double>(c.branch_misses) / bytes
+            );
+        }
+    }
+
+    void print_allocs(std::FILE* out, const std::vector<PhaseStats>& phases, usize width) {
+        if (!alloc_tracking_enabled()) {
+            return;
+        }
+
+        fmt::print(
+            out,
+            "\n{:<{}}  {:>10}  {:>10}  {:>11}  {:>10}\n",
+            "phase",
+            width,
+            "allocs",
+            "bytes",
+            "allocs/call",
+            "peak"
+        );
+        for (const auto& phase : phases) {
+            if (phase.calls == 0) {
+                continue;
+            }
+            const auto& a = phase.allocs;
+            fmt::print(
+                out,
+                "{:<{}}  {:>10}  {:>10}  {:>11}  {:>10}\n",
+                phase.name,
+                width,
+                format_count(static_cast<double>(a.count)),
+                format_bytes(a.bytes),
+                format_count(static_cast<double>(a.count) / static_cast<double>(phase.calls)),
+                format_bytes(a.peak)
+            );
+        }
+    }
+
+    void run_exit_report() {
+        PhaseRegistry::instance().report_at_exit();
+    }
+}  // namespace
+
+PhaseRegistry::PhaseRegistry() : _epoch{Clock::now()} {
+    // NOLINTNEXTLINE(concurrency-mt-unsafe): read once during startup
+    const char* trace_path = std::getenv("AOC_TRACE_JSON");
+    _tracing = trace_path != nullptr && *trace_path != '\0';
+}
+
+PhaseRegistry& PhaseRegistry::instance() {
+    static PhaseRegistry registry{};
+    static const bool registered = [] {
+        return std::atexit(run_exit_report) == 0;
+    }();
+    unused(registered);
+
+    return registry;
+}
+
+usize PhaseRegistry::id(std::string_view name) {
+    std::scoped_lock lock{_mutex};
+    auto it = std::ranges::find(_phases, name, &PhaseStats::name);
+    if (it != _phases.end()) {
+        return static_cast<usize>(it - _phases.begin());
+    }
+
+    _phases.push_back({std::string{name}});
+    return _phases.size() - 1;
+}
+
+void PhaseRegistry::record(usize id, const PhaseSample& sample) {
+    std::scoped_lock lock{_mutex};
+    auto& phase = _phases.at(id);
+    phase.calls++;
+    phase.total += sample.elapsed;
+    phase.min = std::min(phase.min, sample.elapsed);
+    phase.max = std::max(phase.max, sample.elapsed);
+    if (sample.counters.has_value()) {
+        phase.counters += *sample.counters;
+        phase.counted_calls++;
+        phase.input_bytes += sample.input_bytes;
+    }
+    phase.allocs.count += sample.allocs.count;
+    phase.allocs.bytes += sample.allocs.bytes;
+    phase.allocs.peak = std::max(phase.allocs.peak, sample.allocs.peak);
+
+    if (_tracing) {
+        TraceEvent event{id, thread_index(), sample.start, sample.elapsed, sample.allocs};
+        if (_events.size() < _trace_capacity) {
+            _events.push_back(event);
+        } else if (_trace_capacity > 0) {
+            _events[_next_event] = event;
+            _next_event = (_next_event + 1) % _trace_capacity;
+            _dropped_events++;
+        } else {
+            _dropped_events++;
+        }
+    }
+}
+
+std::vector<PhaseStats> PhaseRegistry::stats() const {
+    std::scoped_lock lock{_mutex};
+    return _phases;
+}
+
+std::optional<PhaseStats> PhaseRegistry::find(std::string_view name) const {
+    std::scoped_lock lock{_mutex};
+    auto it = std::ranges::find(_phases, name, &PhaseStats::name);
+    if (it == _phases.end()) {
+        return {};
+    }
+    return *it;
+}
+
+void PhaseRegistry::clear() {
+    std::scoped_lock lock{_mutex};
+    _phases.clear();
+    _events.clear();
+    _next_event = 0;
+    _dropped_events = 0;
+}
+
+bool PhaseRegistry::tracing() const {
+    std::scoped_lock lock{_mutex};
+    return _tracing;
+}
+
+void PhaseRegistry::set_tracing(bool enabled) {
+    std::scoped_lock lock{_mutex};
+    _tracing = enabled;
+}
+
+usize PhaseRegistry::trace_capacity() const {
+    std::scoped_lock lock{_mutex};
+    return _trace_capacity;
+}
+
+void PhaseRegistry::set_trace_capacity(usize capacity) {
+    std::scoped_lock lock{_mutex};
+    std::ranges::rotate(_events, _events.begin() + static_cast<std::ptrdiff_t>(_next_event));
+    if (_events.size() > capacity) {
+        auto excess = _events.size() - capacity;
+        _events.erase(_events.begin(), _events.begin() + static_cast<std::ptrdiff_t>(excess));
+        _dropped_events += excess;
+    }
+    _trace_capacity = capacity;
+    _next_event = 0;
+}
+
+void PhaseRegistry::set_thread_name(std::string_view name) {
+    auto thread = thread_index();
+    std::scoped_lock lock{_mutex};
+    auto it = std::ranges::find(_thread_names, thread, &std::pair<u32, std::string>::first);
+    if (it != _thread_names.end()) {
+        it->second = name;
+    } else {
+        _thread_names.emplace_back(thread, name);
+    }
+}
+
+void PhaseRegistry::write_trace(std::ostream& os) const {
+    std::scoped_lock lock{_mutex};
+
+    // complete ("X") events with microsecond timestamps relative to startup, see the Trace
+    // Event Format spec. everything is reported under a single process.
+    auto micros = [](Clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count();
+    };
+
+    os << R"({"displayTimeUnit":"ms","traceEvents":[)";
+    os << R"({"name":"process_name","ph":"M","pid":1,"tid":0,"args":{"name":"aoc"}})";
+    for (const auto& [thread, name] : _thread_names) {
+        os << R"(,{"name":"thread_name","ph":"M","pid":1,"tid":)" << thread
+           << R"(,"args":{"name":")" << escape_json(name) << R"("}})";
+    }
+    for (usize i = 0; i < _events.size(); ++i) {
+        const auto& event = _events[(_next_event + i) % _events.size()];
+        os << fmt::format(
+            R"(,{{"name":"{}","cat":"phase","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f})",
+            escape_json(_phases.at(event.phase).name),
+            event.thread,
+            micros(event.start - _epoch),
+            micros(event.elapsed)
+        );
+        if (alloc_tracking_enabled()) {
+            os << fmt::format(
+                R"(,"args":{{"allocs":{},"alloc_bytes":{},"peak_bytes":{}}})",
+                event.allocs.count,
+                event.allocs.bytes,
+                event.allocs.peak
+            );
+        }
+        os << "}";
+    }
+    os << "]";
+    if (_dropped_events > 0) {
+        os << fmt::format(R"(,"otherData":{{"dropped_events":{}}})", _dropped_events);
+    }
+    os << "}\n";
+}
+
+void PhaseRegistry::print_summary(std::FILE* out) const {
+    auto phases = stats();
+
+    usize width = 5;
+    for (const auto& phase : phases) {
+        width = std::max(width, phase.name.size());
+    }
+
+    fmt::print(
+        out,
+        "\n{:<{}}  {:>6}  {:>10}  {:>10}  {:>10}  {:>10}\n",
+        "phase",
+        width,
+        "calls",
+        "total",
+        "mean",
+        "min",
+        "max"
+    );
+    for (const auto& phase : phases) {
+        if (phase.calls == 0) {
+            continue;
+        }
+        auto mean = phase.total / static_cast<i64>(phase.calls);
+        fmt::print(
+            out,
+            "{:<{}}  {:>6}  {:>10}  {:>10}  {:>10}  {:>10}\n",
+            phase.name,
+            width,
+            phase.calls,
+            format_duration(phase.total),
+            format_duration(mean),
+            format_duration(phase.min),
+            format_duration(phase.max)
+        );
+    }
+
+    print_counters(out, phases, width);
+    print_allocs(out, phases, width);
+}
+
+void PhaseRegistry::report_at_exit() const {
+    if (stats().empty()) {
+        return;
+    }
+
+    // NOLINTBEGIN(concurrency-mt-unsafe): only read at exit
+    const char* timing = std::getenv("AOC_TIMING");
+    const char* json_path = std::getenv("AOC_TIMING_JSON");
+    const char* trace_path = std::getenv("AOC_TRACE_JSON");
+    // NOLINTEND(concurrency-mt-unsafe)
+
+    if (timing == nullptr || std::string_view{timing} != "0") {
+        print_summary(stderr);
+    }
+
+    if (json_path != nullptr && *json_path != '\0') {
+        std::ofstream out{json_path};
+        if (out) {
+            write_json(out);
+        } else {
+            spdlog::error("Failed to write timing report to `{}`", json_path);
+        }
+    }
+    if (trace_path != nullptr && *trace_path != '\0' && tracing()) {
+        std::ofstream out{trace_path};
+        if (out) {
+            write_trace(out);
+            std::scoped_lock lock{_mutex};
+            if (_dropped_events > 0) {
+                spdlog::warn(
+                    "Trace kept the last {} phase runs, {} older ones were dropped",
+                    _events.size(),
+                    _dropped_events
+                );
+            }
+        } else {
+            spdlog::error("Failed to write trace to `{}`", trace_path);
+        }
+    }
+}
+
+void PhaseRegistry::write_json(std::ostream& os) const {
+    auto phases = stats();
+
+    os << "{\"input_bytes\":" << input_bytes() << ",\"phases\":[";
+    for (usize i = 0; i < phases.size(); ++i) {
+        const auto& phase = phases[i];
+        auto calls = static_cast<i64>(phase.calls);
+        auto mean = calls == 0 ? 0 : to_nanos(phase.total) / calls;
+        auto min = calls == 0 ? 0 : to_nanos(phase.min);
+
+        os << (i == 0 ? "" : ",") << "{\"name\":\"" << escape_json(phase.name) << "\""
+           << ",\"calls\":" << phase.calls << ",\"total_ns\":" << to_nanos(phase.total)
+           << ",\"mean_ns\":" << mean << ",\"min_ns\":" << min
+           << ",\"max_ns\":" << to_nanos(phase.max);
+        if (phase.counted_calls > 0) {
+            const auto& c = phase.counters;
+            os << ",\"cycles\":" << c.cycles << ",\"instructions\":" << c.instructions
+               << ",\"cache_misses\":" << c.cache_misses
+               << ",\"branch_misses\":" << c.branch_misses << ",\"ipc\":" << c.ipc()
+               << ",\"input_bytes\":" << counted_bytes(phase);
+        }
+        if (alloc_tracking_enabled()) {
+            os << ",\"allocs\":" << phase.allocs.count << ",\"alloc_bytes\":" << phase.allocs.bytes
+               << ",\"peak_bytes\":" << phase.allocs.peak;
+        }
+        os << "}";
+    }
+    os << "]}\n";
+}
+
+ScopedTimer::ScopedTimer(std::string_view phase, usize input_bytes)
+    : _phase{PhaseRegistry::instance().id(phase)},
+      _input_bytes{input_bytes} {
+    if (PerfCounters::enabled()) {
+        const auto& counters = PerfCounters::for_this_thread();
+        if (counters.available()) {
+            _perf = &counters;
+            _perf_start = counters.read_attributed();
+        }
+    }
+    _alloc = alloc_begin();
+    _start = Clock::now();
+}
+
+ScopedTimer::~ScopedTimer() {
+    PhaseSample sample{_start, elapsed()};
+    sample.allocs = alloc_end(_alloc);
+    sample.input_bytes = _input_bytes;
+    if (_perf != nullptr) {
+        sample.counters = _perf->read_attributed() - _perf_start;
+    }
+
+    // the registry may allocate (e.g. growing its phase table), which is counted against
+    // the enclosing phase rather than this one
+    PhaseRegistry::instance().record(_phase, sample);
+}
+
+u32 thread_index() {
+    static std::atomic<u32> next{};
+    thread_local const u32 index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+Clock::duration ScopedTimer::elapsed() const {
+    return Clock::now() - _start;
+}
+
+}  // namespace aoc
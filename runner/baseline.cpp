@@ -0,0 +1,156 @@
+#include "baseline.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <iterator>
+#include <span>
+
+namespace runner {
+
+namespace {
+    // largest p-value that still counts as a real change rather than noise
+    constexpr aoc::f64 ALPHA{0.01};
+
+    std::optional<aoc::f64> parse_sample(std::string_view s) {
+        aoc::f64 value{};
+        auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+        if (ec != std::errc{} || ptr != s.data() + s.size()) {
+            return {};
+        }
+        return value;
+    }
+}  // namespace
+
+void SampleSet::add(std::string_view name, aoc::f64 ns) {
+    auto it = std::ranges::find(_series, name, [](const auto& s) { return s.first; });
+    if (it == _series.end()) {
+        _series.emplace_back(std::string{name}, std::vector<aoc::f64>{});
+        it = std::prev(_series.end());
+    }
+    it->second.push_back(ns);
+}
+
+void SampleSet::merge(const SampleSet& other) {
+    for (const auto& [name, samples] : other) {
+        for (auto ns : samples) {
+            add(name, ns);
+        }
+    }
+}
+
+const std::vector<aoc::f64>* SampleSet::find(std::string_view name) const {
+    auto it = std::ranges::find(_series, name, [](const auto& s) { return s.first; });
+    return it == _series.end() ? nullptr : &it->second;
+}
+
+bool save_baseline(const std::filesystem::path& path, const SampleSet& samples) {
+    std::ofstream out{path};
+    if (!out) {
+        spdlog::error("Failed to write baseline to `{}`", path.string());
+        return false;
+    }
+
+    out << "# aoc baseline: series name, then every sample in nanoseconds\n";
+    for (const auto& [name, values] : samples) {
+        out << name << fmt::format(" {:.0f}\n", fmt::join(values, " "));
+    }
+    return true;
+}
+
+std::optional<SampleSet> load_baseline(const std::filesystem::path& path) {
+    std::ifstream in{path};
+    if (!in) {
+        spdlog::error("Failed to read baseline `{}`", path.string());
+        return {};
+    }
+
+    SampleSet samples{};
+    std::string line{};
+    for (aoc::usize n = 1; std::getline(in, line); ++n) {
+        auto fields =
+            aoc::split(line, ' ', aoc::SplitOptions::Trim | aoc::SplitOptions::DiscardEmpty);
+        if (fields.empty() || fields.front().starts_with('#')) {
+            continue;
+        }
+        for (auto field : std::span{fields}.subspan(1)) {
+            auto ns = parse_sample(field);
+            if (!ns.has_value()) {
+                spdlog::error("Invalid sample `{}` in `{}` line {}", field, path.string(), n);
+                return {};
+            }
+            samples.add(fields.front(), *ns);
+        }
+    }
+    return samples;
+}
+
+aoc::usize compare_baseline(
+    const SampleSet& baseline,
+    const SampleSet& current,
+    aoc::f64 threshold
+) {
+    aoc::usize width = 5;
+    for (const auto& [name, _] : current) {
+        width = std::max(width, name.size());
+    }
+
+    fmt::println(
+        "\n{:<{}} {:>10} {:>10} {:>8} {:>8}  {}",
+        "phase",
+        width,
+        "baseline",
+        "current",
+        "delta",
+        "p-value",
+        "verdict"
+    );
+
+    aoc::usize regressions{};
+    for (const auto& [name, samples] : current) {
+        auto now = aoc::describe(samples).median;
+        const auto* before = baseline.find(name);
+        if (before == nullptr) {
+            fmt::println(
+                "{:<{}} {:>10} {:>10} {:>8} {:>8}  new",
+                name,
+                width,
+                "-",
+                aoc::format_nanos(now),
+                "-",
+                "-"
+            );
+            continue;
+        }
+
+        auto then = aoc::describe(*before).median;
+        auto p = aoc::mann_whitney(*before, samples);
+
+        // a relative change from a zero median is meaningless, so it never gets a verdict
+        std::string_view verdict{"~"};
+        std::string delta{"-"};
+        if (then > 0) {
+            auto change = (now - then) / then;
+            if (p < ALPHA && change > threshold) {
+                verdict = "SLOWER";
+                regressions++;
+            } else if (p < ALPHA && change < -threshold) {
+                verdict = "faster";
+            }
+            delta = fmt::format("{:+.1f}%", change * 100.0);
+        }
+        fmt::println(
+            "{:<{}} {:>10} {:>10} {:>8} {:>8}  {}",
+            name,
+            width,
+            aoc::format_nanos(then),
+            aoc::format_nanos(now),
+            delta,
+            p < 0.001 ? "<0.001" : fmt::format("{:.3f}", p),
+            verdict
+        );
+    }
+    return regressions;
+}
+
+}  // namespace runner
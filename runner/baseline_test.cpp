@@ -0,0 +1,60 @@
+#include "baseline.hpp"
+
+#include <gtest/gtest.h>
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+namespace {
+
+runner::SampleSet series(std::string_view name, std::initializer_list<aoc::f64> samples) {
+    runner::SampleSet set{};
+    for (auto ns : samples) {
+        set.add(name, ns);
+    }
+    return set;
+}
+
+}  // namespace
+
+TEST(RunnerBaseline, CountsRegressions) {
+    auto before = series("day2/total", {100, 101, 102, 103, 104, 105, 106, 107});
+    auto after = series("day2/total", {200, 201, 202, 203, 204, 205, 206, 207});
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(runner::compare_baseline(before, after, 0.05), 1);
+    EXPECT_EQ(runner::compare_baseline(after, before, 0.05), 0);
+    auto output = testing::internal::GetCapturedStdout();
+
+    EXPECT_NE(output.find("SLOWER"), std::string::npos) << output;
+    EXPECT_NE(output.find("faster"), std::string::npos) << output;
+}
+
+TEST(RunnerBaseline, ZeroMedian) {
+    auto before = series("day1/parse", {0, 0, 0, 0, 0, 0, 0, 0});
+    auto after = series("day1/parse", {10, 11, 12, 13, 14, 15, 16, 17});
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(runner::compare_baseline(before, after, 0.05), 0);
+    auto output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(output.find("inf"), std::string::npos) << output;
+    EXPECT_EQ(output.find("nan"), std::string::npos) << output;
+    EXPECT_NE(output.find(" - "), std::string::npos) << output;
+}
+
+TEST(RunnerBaseline, AlignsLongNames) {
+    auto before = series("day10/pipeline", {100, 100, 100});
+    before.add("day1/parse", 100);
+    auto after = before;
+
+    testing::internal::CaptureStdout();
+    runner::compare_baseline(before, after, 0.05);
+    auto output = testing::internal::GetCapturedStdout();
+
+    // every row starts its baseline column at the same offset
+    EXPECT_NE(output.find("day10/pipeline "), std::string::npos) << output;
+    EXPECT_NE(output.find("day1/parse     "), std::string::npos) << output;
+    EXPECT_NE(output.find("phase          "), std::string::npos) << output;
+}
@@ -0,0 +1,274 @@
+#include "batch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+namespace runner {
+
+namespace {
+    // phases a run can record, in the column order of the CSV report
+    constexpr std::array<std::string_view, 5> PHASES{
+        "cache", "parse", "part1", "part2", "pipeline"
+    };
+
+    std::optional<aoc::u32> parse_day_number(std::string_view s) {
+        aoc::u32 value{};
+        auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+        if (ec != std::errc{} || ptr != s.data() + s.size()) {
+            return {};
+        }
+        return value;
+    }
+
+    // `day5.txt` and `day5_example.txt` are day 5, `day51.txt` is not
+    const Day* day_from_name(const std::filesystem::path& path) {
+        auto name = path.filename().string();
+        std::string_view rest{name};
+        if (!rest.starts_with("day")) {
+            return nullptr;
+        }
+        rest.remove_prefix(3);
+        auto digits = std::ranges::find_if_not(rest, [](char c) { return c >= '0' && c <= '9'; });
+        auto number = parse_day_number({rest.begin(), digits});
+        return number.has_value() ? find_day(*number) : nullptr;
+    }
+
+    bool selected(const Day* day, std::span<const aoc::u32> days) {
+        return days.empty() || std::ranges::find(days, day->number) != days.end();
+    }
+
+    std::optional<std::vector<BatchInput>> read_manifest(
+        const std::filesystem::path& manifest,
+        std::span<const aoc::u32> days
+    ) {
+        std::ifstream in{manifest};
+        if (!in) {
+            spdlog::error("Failed to read batch manifest `{}`", manifest.string());
+            return {};
+        }
+
+        std::vector<BatchInput> inputs{};
+        std::string line{};
+        for (aoc::usize n = 1; std::getline(in, line); ++n) {
+            auto fields =
+                aoc::split(line, ' ', aoc::SplitOptions::Trim | aoc::SplitOptions::DiscardEmpty);
+            if (fields.empty() || fields.front().starts_with('#')) {
+                continue;
+            }
+            if (fields.size() > 2) {
+                spdlog::error("Expected `[DAY] PATH` in `{}` line {}", manifest.string(), n);
+                return {};
+            }
+
+            auto path = manifest.parent_path() / fields.back();
+            const Day* day{};
+            if (fields.size() == 2) {
+                auto number = parse_day_number(fields.front());
+                day = number.has_value() ? find_day(*number) : nullptr;
+            } else {
+                day = day_from_name(path);
+            }
+            if (day == nullptr) {
+                spdlog::error("No day for `{}` in `{}` line {}", line, manifest.string(), n);
+                return {};
+            }
+            if (!std::filesystem::is_regular_file(path)) {
+                spdlog::error("Input file `{}` does not exist", path.string());
+                return {};
+            }
+            if (selected(day, days)) {
+                inputs.push_back({day, std::move(path)});
+            }
+        }
+        return inputs;
+    }
+
+    // Arenas of the inputs being solved, reused from one input to the next. They cannot be
+    // one per thread: a pool thread waiting on a day's own parallel work may pick up another
+    // input, whose reset would free the first input's data under it.
+    class ArenaPool {
+    public:
+        std::unique_ptr<aoc::Arena> acquire() {
+            std::lock_guard lock{_mutex};
+            if (_free.empty()) {
+                return std::make_unique<aoc::Arena>();
+            }
+            auto arena = std::move(_free.back());
+            _free.pop_back();
+            return arena;
+        }
+
+        void release(std::unique_ptr<aoc::Arena> arena) {
+            arena->reset();
+            std::lock_guard lock{_mutex};
+            _free.push_back(std::move(arena));
+        }
+
+    private:
+        std::mutex _mutex{};
+        std::vector<std::unique_ptr<aoc::Arena>> _free{};
+    };
+
+    aoc::f64 to_nanos(aoc::Clock::duration d) {
+        return std::chrono::duration<aoc::f64, std::nano>{d}.count();
+    }
+
+    const PhaseTime* find_phase(const Answers& answers, std::string_view name) {
+        auto it = std::ranges::find(answers.timings, name, &PhaseTime::name);
+        return it == answers.timings.end() ? nullptr : &*it;
+    }
+
+    void write_csv(
+        std::ostream& os,
+        std::span<const BatchInput> inputs,
+        std::span<const BatchResult> results
+    ) {
+        os << "file,day,part1,part2,total_ns";
+        for (auto phase : PHASES) {
+            os << ',' << phase << "_ns";
+        }
+        os << ",error\n";
+
+        for (aoc::usize i = 0; i < inputs.size(); ++i) {
+            const auto& [answers, elapsed, error] = results[i];
+            os << csv_field(inputs[i].path.generic_string()) << ',' << inputs[i].day->number
+               << ',' << csv_field(answers.part1) << ','
+               << csv_field(answers.part2.value_or("")) << ','
+               << fmt::format("{:.0f}", to_nanos(elapsed));
+            for (auto phase : PHASES) {
+                os << ',';
+                if (const auto* p = find_phase(answers, phase)) {
+                    os << fmt::format("{:.0f}", to_nanos(p->elapsed));
+                }
+            }
+            os << ',' << csv_field(error) << '\n';
+        }
+    }
+
+    void write_json_lines(
+        std::ostream& os,
+        std::span<const BatchInput> inputs,
+        std::span<const BatchResult> results
+    ) {
+        for (aoc::usize i = 0; i < inputs.size(); ++i) {
+            const auto& [answers, elapsed, error] = results[i];
+            const auto& [day, path] = inputs[i];
+            os << fmt::format("{{\"file\":{:?},\"day\":{}", path.generic_string(), day->number);
+            if (error.empty()) {
+                os << fmt::format(",\"part1\":{:?}", answers.part1);
+                if (answers.part2.has_value()) {
+                    os << fmt::format(",\"part2\":{:?}", *answers.part2);
+                }
+            } else {
+                os << fmt::format(",\"error\":{:?}", error);
+            }
+            os << fmt::format(",\"total_ns\":{:.0f},\"phases\":{{", to_nanos(elapsed));
+            for (aoc::usize p = 0; p < answers.timings.size(); ++p) {
+                const auto& phase = answers.timings[p];
+                os << (p == 0 ? "" : ",")
+                   << fmt::format("{:?}:{:.0f}", phase.name, to_nanos(phase.elapsed));
+            }
+            os << "}}\n";
+        }
+    }
+}  // namespace
+
+std::optional<std::vector<BatchInput>> find_batch_inputs(
+    const std::filesystem::path& source,
+    std::span<const aoc::u32> days
+) {
+    if (!std::filesystem::exists(source)) {
+        spdlog::error("Batch source `{}` does not exist", source.string());
+        return {};
+    }
+    if (!std::filesystem::is_directory(source)) {
+        return read_manifest(source, days);
+    }
+
+    std::vector<BatchInput> inputs{};
+    for (const auto& entry : std::filesystem::directory_iterator{source}) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+        const auto* day = day_from_name(entry.path());
+        if (day != nullptr && selected(day, days)) {
+            inputs.push_back({day, entry.path()});
+        }
+    }
+
+    // directory order is unspecified, the report should not be
+    std::ranges::sort(inputs, [](const auto& a, const auto& b) {
+        return std::pair{a.day->number, a.path} < std::pair{b.day->number, b.path};
+    });
+    return inputs;
+}
+
+std::string csv_field(std::string_view s) {
+    if (s.find_first_of(",\"\n") == std::string_view::npos) {
+        return std::string{s};
+    }
+    std::string quoted{"\""};
+    for (auto c : s) {
+        quoted += c;
+        if (c == '"') {
+            quoted += '"';
+        }
+    }
+    return quoted + '"';
+}
+
+std::vector<BatchResult> run_batch(
+    std::span<const BatchInput> inputs,
+    bool pipeline,
+    const ResultCache* cache
+) {
+    std::vector<BatchResult> results(inputs.size());
+    ArenaPool arenas{};
+    aoc::parallel_for(
+        0,
+        inputs.size(),
+        [&](aoc::usize i) {
+            const auto& [day, path] = inputs[i];
+            const auto& solve = pipeline && day->pipelined ? day->pipelined : day->run;
+            auto arena = arenas.acquire();
+
+            auto& result = results[i];
+            auto start = aoc::Clock::now();
+            try {
+                auto solve_once = [&] { return solve(path, arena.get()); };
+                result.answers =
+                    cache != nullptr ? cache->solve(*day, path, solve_once) : solve_once();
+            } catch (const std::exception& e) {
+                result.error = e.what();
+            }
+            result.elapsed = aoc::Clock::now() - start;
+            arenas.release(std::move(arena));
+        },
+        1
+    );
+    return results;
+}
+
+void write_batch(
+    std::ostream& os,
+    std::span<const BatchInput> inputs,
+    std::span<const BatchResult> results,
+    BatchFormat format
+) {
+    AOC_ASSERT(inputs.size() == results.size(), "Every batch input needs a result");
+    if (format == BatchFormat::Csv) {
+        write_csv(os, inputs, results);
+    } else {
+        write_json_lines(os, inputs, results);
+    }
+}
+
+}  // namespace runner
@@ -0,0 +1,127 @@
+#include "batch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr std::string_view DAY7_EXAMPLE{
+    "32T3K 765\n"
+    "T55J5 684\n"
+    "KK677 28\n"
+    "KTJJT 220\n"
+    "QQQJA 483\n"
+};
+
+// empty directory named after the running test
+std::filesystem::path test_dir() {
+    const auto* test = testing::UnitTest::GetInstance()->current_test_info();
+    auto dir = std::filesystem::temp_directory_path()
+        / (std::string{"aoc_batch_"} + test->name());
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+void write_file(const std::filesystem::path& path, std::string_view contents) {
+    std::ofstream out{path, std::ios::binary};
+    out << contents;
+}
+
+std::vector<std::string> names(const std::vector<runner::BatchInput>& inputs) {
+    std::vector<std::string> result{};
+    for (const auto& input : inputs) {
+        result.push_back(fmt::format("{} {}", input.day->number, input.path.filename().string()));
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(RunnerBatch, FindsInputsInDirectory) {
+    auto dir = test_dir();
+    for (auto name : {"day7.txt", "day5_variant.txt", "day5.txt", "day51.txt", "notes.txt"}) {
+        write_file(dir / name, "");
+    }
+    std::filesystem::create_directory(dir / "day6");
+
+    auto inputs = runner::find_batch_inputs(dir, {});
+    ASSERT_TRUE(inputs.has_value());
+    EXPECT_EQ(
+        names(*inputs),
+        (std::vector<std::string>{"5 day5.txt", "5 day5_variant.txt", "7 day7.txt"})
+    );
+
+    const std::vector<aoc::u32> day7{7};
+    inputs = runner::find_batch_inputs(dir, day7);
+    ASSERT_TRUE(inputs.has_value());
+    EXPECT_EQ(names(*inputs), std::vector<std::string>{"7 day7.txt"});
+
+    EXPECT_FALSE(runner::find_batch_inputs(dir / "missing", {}).has_value());
+    std::filesystem::remove_all(dir);
+}
+
+TEST(RunnerBatch, ReadsManifest) {
+    auto dir = test_dir();
+    write_file(dir / "day5.txt", "");
+    write_file(dir / "other.txt", "");
+    write_file(
+        dir / "manifest",
+        "# inputs\n"
+        "\n"
+        "  day5.txt\n"
+        "7 other.txt\n"
+    );
+
+    auto inputs = runner::find_batch_inputs(dir / "manifest", {});
+    ASSERT_TRUE(inputs.has_value());
+    EXPECT_EQ(names(*inputs), (std::vector<std::string>{"5 day5.txt", "7 other.txt"}));
+    // paths are relative to the manifest
+    EXPECT_EQ((*inputs)[1].path, dir / "other.txt");
+
+    const std::vector<aoc::u32> day5{5};
+    inputs = runner::find_batch_inputs(dir / "manifest", day5);
+    ASSERT_TRUE(inputs.has_value());
+    EXPECT_EQ(names(*inputs), std::vector<std::string>{"5 day5.txt"});
+
+    // too many fields, no day in the name, unknown day, missing file
+    for (auto manifest : {"7 other.txt x\n", "other.txt\n", "99 other.txt\n", "7 gone.txt\n"}) {
+        write_file(dir / "manifest", manifest);
+        EXPECT_FALSE(runner::find_batch_inputs(dir / "manifest", {}).has_value()) << manifest;
+    }
+    std::filesystem::remove_all(dir);
+}
+
+TEST(RunnerBatch, CsvField) {
+    EXPECT_EQ(runner::csv_field(""), "");
+    EXPECT_EQ(runner::csv_field("12345"), "12345");
+    EXPECT_EQ(runner::csv_field("a,b"), "\"a,b\"");
+    EXPECT_EQ(runner::csv_field("say \"hi\""), "\"say \"\"hi\"\"\"");
+    EXPECT_EQ(runner::csv_field("two\nlines"), "\"two\nlines\"");
+}
+
+TEST(RunnerBatch, ReportsPanicsPerInput) {
+    auto dir = test_dir();
+    write_file(dir / "day7.txt", DAY7_EXAMPLE);
+    write_file(dir / "day7_bad.txt", "XYZ 5\n");
+
+    auto inputs = runner::find_batch_inputs(dir, {});
+    ASSERT_TRUE(inputs.has_value());
+    ASSERT_EQ(inputs->size(), 2);
+
+    aoc::set_panics_throw(true);
+    auto results = runner::run_batch(*inputs, false);
+    aoc::set_panics_throw(false);
+
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0].error, "");
+    EXPECT_EQ(results[0].answers.part1, "6440");
+    EXPECT_EQ(results[0].answers.part2, "5905");
+    EXPECT_NE(results[1].error.find("unknown card"), std::string::npos) << results[1].error;
+    std::filesystem::remove_all(dir);
+}
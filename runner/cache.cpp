@@ -0,0 +1,136 @@
+#include "cache.hpp"
+
+#include <fstream>
+#include <random>
+#include <string>
+#include <system_error>
+
+namespace runner {
+
+namespace {
+    // whole contents of a file, or nothing if it cannot be read
+    std::optional<std::string> read_file(const std::filesystem::path& path) {
+        std::error_code ec{};
+        auto size = std::filesystem::file_size(path, ec);
+        std::ifstream in{path, std::ios::binary};
+        if (ec || !in) {
+            return {};
+        }
+        std::string data(static_cast<aoc::usize>(size), '\0');
+        if (!in.read(data.data(), static_cast<std::streamsize>(data.size()))) {
+            return {};
+        }
+        return data;
+    }
+
+    std::string hex(aoc::u64 hash) {
+        return fmt::format("{:016x}", hash);
+    }
+
+    std::optional<Answers> read_entry(const std::filesystem::path& path) {
+        std::ifstream in{path};
+        if (!in) {
+            return {};
+        }
+        Answers answers{};
+        bool part1{};
+        std::string line{};
+        while (std::getline(in, line)) {
+            auto fields = aoc::split_once(line, ' ');
+            if (!fields.has_value()) {
+                return {};
+            }
+            auto [part, answer] = *fields;
+            if (part == "part1") {
+                answers.part1 = answer;
+                part1 = true;
+            } else if (part == "part2") {
+                answers.part2 = answer;
+            }
+        }
+        if (!part1) {
+            return {};
+        }
+        return answers;
+    }
+
+    void write_entry(const std::filesystem::path& path, const Answers& answers) {
+        // a unique name, so concurrent writers of the same entry do not interleave
+        thread_local std::mt19937_64 rng{std::random_device{}()};
+        auto tmp = path;
+        tmp += fmt::format(".{}.tmp", hex(rng()));
+        {
+            std::ofstream out{tmp};
+            out << "part1 " << answers.part1 << '\n';
+            if (answers.part2.has_value()) {
+                out << "part2 " << *answers.part2 << '\n';
+            }
+            if (!out) {
+                spdlog::warn("Failed to write cache entry `{}`", path.string());
+                return;
+            }
+        }
+        std::error_code ec{};
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) {
+            std::filesystem::remove(tmp, ec);
+        }
+    }
+}  // namespace
+
+std::optional<ResultCache> ResultCache::open(
+    const std::filesystem::path& dir,
+    std::string_view argv0
+) {
+    std::filesystem::path executable{"/proc/self/exe"};
+    if (!std::filesystem::exists(executable)) {
+        executable = argv0;
+    }
+    auto binary = read_file(executable);
+    if (!binary.has_value()) {
+        spdlog::error("Failed to read `{}` to fingerprint the build", executable.string());
+        return {};
+    }
+    auto build = hex(aoc::xxh64(*binary));
+
+    std::error_code ec{};
+    std::filesystem::create_directories(dir / build, ec);
+    if (ec) {
+        spdlog::error("Failed to create cache directory `{}`: {}", dir.string(), ec.message());
+        return {};
+    }
+    return ResultCache{dir / build};
+}
+
+Answers ResultCache::solve(
+    const Day& day,
+    const std::filesystem::path& input,
+    const std::function<Answers()>& solve
+) const {
+    PhaseTime lookup{"cache"};
+    std::optional<std::filesystem::path> entry{};
+    std::optional<Answers> cached{};
+    auto bytes = details::input_size(input);
+    {
+        aoc::ScopedTimer timer{fmt::format("day{}/cache", day.number), bytes};
+        if (auto data = read_file(input)) {
+            entry = _dir / fmt::format("day{}-{}.txt", day.number, hex(aoc::xxh64(*data)));
+            cached = read_entry(*entry);
+        }
+        lookup.elapsed = timer.elapsed();
+    }
+
+    if (cached.has_value()) {
+        cached->timings.push_back(lookup);
+        return *cached;
+    }
+    // unreadable inputs are left to `solve` to report
+    auto answers = solve();
+    if (entry.has_value()) {
+        write_entry(*entry, answers);
+    }
+    answers.timings.insert(answers.timings.begin(), lookup);
+    return answers;
+}
+
+}  // namespace runner
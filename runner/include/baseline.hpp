@@ -0,0 +1,54 @@
+#pragma once
+
+#include "aoc/aoc.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace runner {
+
+// Timing samples in nanoseconds, grouped into named series like `day2/total` (end-to-end
+// runs) or `day2/parse`. Series keep the order they were first added in.
+class SampleSet {
+public:
+    void add(std::string_view name, aoc::f64 ns);
+    void merge(const SampleSet& other);
+
+    // samples of `name`, or `nullptr` if there are none
+    [[nodiscard]]
+    const std::vector<aoc::f64>* find(std::string_view name) const;
+
+    [[nodiscard]]
+    auto begin() const {
+        return _series.begin();
+    }
+
+    [[nodiscard]]
+    auto end() const {
+        return _series.end();
+    }
+
+private:
+    std::vector<std::pair<std::string, std::vector<aoc::f64>>> _series{};
+};
+
+// Baseline files are plain text with one series per line: its name, then every sample. Lines
+// starting with `#` are comments. Both functions log why they failed.
+bool save_baseline(const std::filesystem::path& path, const SampleSet& samples);
+std::optional<SampleSet> load_baseline(const std::filesystem::path& path);
+
+// Prints how the median of each series in `current` moved against `baseline`, and returns
+// the number of regressions: series that got slower by more than `threshold` (e.g. 0.05 for
+// 5%) where the Mann-Whitney U test also rules out noise. Series missing from either side,
+// or with a baseline median of 0, are not regressions.
+aoc::usize compare_baseline(
+    const SampleSet& baseline,
+    const SampleSet& current,
+    aoc::f64 threshold
+);
+
+}  // namespace runner
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "cache.hpp"
+#include "registry.hpp"
+
+#include "aoc/aoc.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace runner {
+
+struct BatchInput {
+    const Day* day{};
+    std::filesystem::path path{};
+};
+
+struct BatchResult {
+    Answers answers{};
+    aoc::Clock::duration elapsed{};
+    // what the run threw, empty if it succeeded
+    std::string error{};
+};
+
+enum class BatchFormat {
+    Csv,
+    Json,
+};
+
+// Collects the inputs of a batch from `source`, which is either a directory or a manifest.
+// Files in a directory are matched to days by name (`day5.txt`, `day5_variant.txt`, ...),
+// and other files are skipped. A manifest lists one input per line as `[DAY] PATH`, where
+// paths are relative to the manifest and the day defaults to the one in the file name. Lines
+// starting with `#` are comments. Only inputs of `days` are kept, unless it is empty. Logs
+// why it failed.
+std::optional<std::vector<BatchInput>> find_batch_inputs(
+    const std::filesystem::path& source,
+    std::span<const aoc::u32> days
+);
+
+// Solves every input once, spread over the global thread pool. Inputs parse into
+// `aoc::Arena`s that are reset and handed to the next input, so memory is reused from one
+// file to the next. With a `cache`, inputs solved before only look up their answers. An input
+// that fails only gets an `error`, which covers panics once `aoc::set_panics_throw` is on.
+// Results are in the order of `inputs`.
+std::vector<BatchResult> run_batch(
+    std::span<const BatchInput> inputs,
+    bool pipeline,
+    const ResultCache* cache = nullptr
+);
+
+// `s` as a CSV field, quoted when it holds a comma, quote or newline
+std::string csv_field(std::string_view s);
+
+// Writes one line per input: CSV with a header, or one JSON object per line. Phases a run
+// did not record (e.g. `pipeline` for regular runs) are left empty in CSV.
+void write_batch(
+    std::ostream& os,
+    std::span<const BatchInput> inputs,
+    std::span<const BatchResult> results,
+    BatchFormat format
+);
+
+}  // namespace runner
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "registry.hpp"
+
+#include "aoc/aoc.hpp"
+
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string_view>
+
+namespace runner {
+
+// Answers of earlier runs, stored on disk and keyed by content rather than by file name:
+//
+//     DIR/<build>/day<N>-<input>.txt
+//
+// where `<input>` is the XXH64 of the input bytes and `<build>` the XXH64 of the runner
+// executable. Each entry holds one `partN ANSWER` line per part. A rebuilt runner gets a
+// new `<build>`, so it never sees answers of an older solver. The entries of other builds
+// are left alone, since several builds (e.g. debug and release) may share one `DIR`. Entries
+// are written to a temporary file and renamed, so several threads or processes can share a
+// cache.
+class ResultCache {
+public:
+    // Opens the cache in `dir`, creating it if needed. `argv0` locates the executable where
+    // `/proc/self/exe` is not available. Logs why it failed.
+    static std::optional<ResultCache> open(
+        const std::filesystem::path& dir,
+        std::string_view argv0
+    );
+
+    // Returns the stored answers for `input` if there are any, otherwise calls `solve` and
+    // stores what it returns. The lookup (hashing the input and reading the entry) is
+    // recorded as the `dayN/cache` phase, so on a hit it is the only phase. Exceptions from
+    // `solve` are passed on and nothing is stored.
+    Answers solve(
+        const Day& day,
+        const std::filesystem::path& input,
+        const std::function<Answers()>& solve
+    ) const;
+
+    // directory of the current build's entries
+    [[nodiscard]]
+    const std::filesystem::path& dir() const {
+        return _dir;
+    }
+
+private:
+    explicit ResultCache(std::filesystem::path dir) : _dir{std::move(dir)} {}
+
+    std::filesystem::path _dir{};
+};
+
+}  // namespace runner
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "aoc/aoc.hpp"
+
+#include <array>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace runner {
+
+// wall time of one phase of a single run, `name` is `parse`, `part1` or `part2`
+struct PhaseTime {
+    std::string_view name{};
+    aoc::Clock::duration elapsed{};
+};
+
+struct Answers {
+    std::string part1{};
+    std::optional<std::string> part2{};
+    std::vector<PhaseTime> timings{};
+};
+
+// Solves one input. Days whose `parse` takes a `std::pmr::memory_resource` allocate the
+// parsed input from `mr`, the others ignore it.
+using Solver = std::function<Answers(const std::filesystem::path&, std::pmr::memory_resource*)>;
+
+// Solves every part again on an input that was parsed once, see `Day::load`.
+using Loaded = std::function<Answers()>;
+
+// Type-erased entry point for one day. `run` parses the input and solves every part,
+// recording the `dayN/parse`, `dayN/part1` and `dayN/part2` phases. The returned answers
+// also hold the wall time of each phase, for benchmark mode.
+struct Day {
+    aoc::u32 number{};
+    Solver run{};
+    // optional, solves every part in one pass over `aoc::run_pipeline`
+    Solver pipelined{};
+    // Parses an input and returns a function that solves it, which can be called any number
+    // of times (also concurrently) while the input stays parsed. The result has no `parse`
+    // timing, and anything it allocated from `mr` must outlive it.
+    std::function<Loaded(const std::filesystem::path&, std::pmr::memory_resource*)> load{};
+    // optional, answers for the default input that the compiler already computed, only in
+    // builds with `AOC_EMBED_INPUTS` (see `runner/registry.cpp`)
+    Loaded embedded{};
+
+    [[nodiscard]]
+    std::filesystem::path default_input() const {
+        return fmt::format("data/day{}.txt", number);
+    }
+};
+
+// Calls `parse(path, mr)` for days that take a memory resource, or `parse(path)`.
+template<auto Parse>
+auto parse_input(const std::filesystem::path& path, std::pmr::memory_resource* mr) {
+    using Path = const std::filesystem::path&;
+    if constexpr (std::is_invocable_v<decltype(Parse), Path, std::pmr::memory_resource*>) {
+        return Parse(path, mr);
+    } else {
+        return Parse(path);
+    }
+}
+
+namespace details {
+    // size of the input file for the phases' counter reports, 0 if it cannot be read
+    inline aoc::usize input_size(const std::filesystem::path& path) {
+        std::error_code ec{};
+        auto size = std::filesystem::file_size(path, ec);
+        return ec ? 0 : static_cast<aoc::usize>(size);
+    }
+
+    // runs `fn` as the `dayN/<phase.name>` phase over `bytes` of input and stores its wall
+    // time in `phase`
+    template<typename F>
+    auto timed(aoc::u32 number, aoc::usize bytes, PhaseTime& phase, F&& fn) {
+        aoc::ScopedTimer timer{fmt::format("day{}/{}", number, phase.name), bytes};
+        auto result = fn();
+        phase.elapsed = timer.elapsed();
+        return result;
+    }
+
+    // Solves every part of a parsed input. With `concurrent`, part 1 and part 2 run at the
+    // same time, see `aoc::solve_concurrently`.
+    template<auto Part1, auto Part2, typename Input>
+    void solve_parts(
+        aoc::u32 number,
+        aoc::usize bytes,
+        const Input& input,
+        bool concurrent,
+        Answers& answers
+    ) {
+        PhaseTime time1{"part1"};
+        auto part1 = [&](const Input& in) {
+            return fmt::to_string(timed(number, bytes, time1, [&] { return Part1(in); }));
+        };
+        if constexpr (std::is_null_pointer_v<decltype(Part2)>) {
+            answers.part1 = part1(input);
+            answers.timings.push_back(time1);
+        } else {
+            PhaseTime time2{"part2"};
+            auto part2 = [&](const Input& in) {
+                return fmt::to_string(timed(number, bytes, time2, [&] { return Part2(in); }));
+            };
+            if (concurrent) {
+                // already parsed, so the "parse" step only hands out the input
+                auto parsed = [&input]() -> const Input& { return input; };
+                std::tie(answers.part1, answers.part2) =
+                    aoc::solve_concurrently(parsed, part1, part2);
+            } else {
+                answers.part1 = part1(input);
+                answers.part2 = part2(input);
+            }
+            answers.timings.push_back(time1);
+            answers.timings.push_back(time2);
+        }
+    }
+
+    template<auto Parse, auto Part1, auto Part2>
+    Day make_day(aoc::u32 number, bool concurrent) {
+        Day day{number};
+        day.run = [number, concurrent](const std::filesystem::path& path, auto* mr) {
+            Answers answers{};
+            PhaseTime parse{"parse"};
+            auto bytes = input_size(path);
+            auto input = timed(number, bytes, parse, [&] { return parse_input<Parse>(path, mr); });
+            answers.timings.push_back(parse);
+            solve_parts<Part1, Part2>(number, bytes, input, concurrent, answers);
+            return answers;
+        };
+        day.load = [number, concurrent](const std::filesystem::path& path, auto* mr) {
+            using Input = decltype(parse_input<Parse>(path, mr));
+            auto input = std::make_shared<const Input>(parse_input<Parse>(path, mr));
+            return Loaded{[number, concurrent, input, bytes = input_size(path)] {
+                Answers answers{};
+                solve_parts<Part1, Part2>(number, bytes, *input, concurrent, answers);
+                return answers;
+            }};
+        };
+        return day;
+    }
+}  // namespace details
+
+// Builds a registry entry from a day's `parse(path)` (or `parse(path, mr)`) and
+// `partN(const Input&)` functions. Days without a second part leave `Part2` as `nullptr`.
+template<auto Parse, auto Part1, auto Part2 = nullptr>
+Day make_day(aoc::u32 number) {
+    return details::make_day<Parse, Part1, Part2>(number, false);
+}
+
+// Like `make_day`, but once the input is parsed, part 1 and part 2 run concurrently with
+// `aoc::solve_concurrently`.
+template<auto Parse, auto Part1, auto Part2>
+Day make_concurrent_day(aoc::u32 number) {
+    return details::make_day<Parse, Part1, Part2>(number, true);
+}
+
+// Adds a day's `solve_pipelined(path)`, which returns both answers as a pair. It is recorded
+// as the `dayN/pipeline` phase, since parsing and solving overlap. The pipeline's stages own
+// their records, so it ignores the memory resource.
+template<auto Solve>
+Day with_pipeline(Day day) {
+    day.pipelined = [number = day.number](const std::filesystem::path& path, auto* /*mr*/) {
+        Answers answers{};
+        auto bytes = details::input_size(path);
+        aoc::ScopedTimer timer{fmt::format("day{}/pipeline", number), bytes};
+        auto [part1, part2] = Solve(path);
+        answers.timings.push_back({"pipeline", timer.elapsed()});
+
+        answers.part1 = fmt::to_string(part1);
+        answers.part2 = fmt::to_string(part2);
+        return answers;
+    };
+    return day;
+}
+
+// every registered day, ordered by day number
+const std::vector<Day>& days();
+
+// looks up a day by number, or `nullptr` if it is not registered
+const Day* find_day(aoc::u32 number);
+
+}  // namespace runner
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "registry.hpp"
+
+#include "aoc/aoc.hpp"
+
+#include <filesystem>
+#include <future>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace runner {
+
+// Resident solver for repeated queries. Requests are lines of `DAY [PATH]`, where `PATH`
+// defaults to `data/dayN.txt`, and each gets one JSON line back:
+//
+//     5 data/day5.txt
+//     {"day":5,"input":"data/day5.txt","part1":"...","part2":"...","cached":false,
+//      "parse_ns":..,"solve_ns":..,"phases":{"part1":..,"part2":..}}
+//
+// Inputs are parsed on first use and stay parsed (each in its own `aoc::Arena`), so later
+// requests for the same file only solve. A file whose size or modification time changed is
+// parsed again. Failed requests get `{"error":"..."}`, which covers malformed inputs that
+// panic once `aoc::set_panics_throw` is on, and a `quit` line stops the server. Requests can
+// be handled from several threads at once.
+class Server {
+public:
+    // Answers one request line, or returns an empty string for `quit` and sets `stop`. Blank
+    // lines are answered with an empty string too, without setting `stop`.
+    std::string handle(std::string_view request, bool& stop);
+
+    // Answers requests from `in` on `out` until the input ends or a client sent `quit`.
+    // Returns false if it stopped because of `quit`.
+    bool serve(std::istream& in, std::ostream& out);
+
+    // number of inputs held, including ones still being parsed
+    [[nodiscard]]
+    aoc::usize cached() const;
+
+private:
+    struct Entry {
+        // declared before `solve`, whose input lives in it
+        std::unique_ptr<aoc::Arena> arena{};
+        Loaded solve{};
+        aoc::Clock::duration parse_time{};
+    };
+
+    // one version of an input, `entry` is ready once the request that parses it is done
+    struct Slot {
+        std::filesystem::file_time_type modified{};
+        std::uintmax_t size{};
+        std::shared_future<std::shared_ptr<const Entry>> entry{};
+    };
+
+    // parsed input of `path`, loading it if needed, sets `parsed` if it was just loaded
+    std::shared_ptr<const Entry> load(
+        const Day& day,
+        const std::filesystem::path& path,
+        bool& parsed
+    );
+
+    // only held to look up or replace a slot, parsing happens outside of it
+    mutable std::mutex _mutex{};
+    std::map<std::pair<aoc::u32, std::filesystem::path>, Slot> _entries{};
+};
+
+// Listens on a Unix domain socket at `path`, replacing any socket file already there, and
+// serves every connection on its own thread until a client sends `quit`. Only available on
+// POSIX systems. Logs why it failed and returns false, also when accepting a connection fails
+// (e.g. out of file descriptors), after the open connections were closed.
+bool serve_socket(Server& server, const std::filesystem::path& path);
+
+}  // namespace runner
@@ -0,0 +1,646 @@
+#include "baseline.hpp"
+#include "batch.hpp"
+#include "cache.hpp"
+#include "server.hpp"
+#include "registry.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr std::string_view USAGE{
+    "Usage: aoc [--day N]... [--all] [--input PATH] [--repeat N | --bench N] [--threads N]\n"
+    "           [--pipeline] [--arena | --huge-pages] [--cache DIR] [--embedded]\n"
+    "       aoc --batch PATH [--day N]... [--format csv|json] [--output PATH] [--threads N]\n"
+    "           [--pipeline] [--cache DIR]\n"
+    "       aoc --serve | --socket PATH [--threads N]\n"
+    "\n"
+    "Options:\n"
+    "  --day N        run day N, can be given more than once\n"
+    "  --all          run every registered day\n"
+    "  --input PATH   read input from PATH instead of data/dayN.txt (single day only)\n"
+    "  --repeat N     solve each day N times, timings accumulate per phase (default 1)\n"
+    "  --threads N    run days in parallel on a pool of N threads, 0 uses every hardware\n"
+    "                 thread (default: one day at a time, the pool uses every hardware thread)\n"
+    "  --pipeline     solve days that support it (2, 4, 7 and 9) in one pass, with reading,\n"
+    "                 parsing and solving on separate threads\n"
+    "  --arena        parse days that support it (4 and 8) into an `aoc::Arena`, which is\n"
+    "                 freed in one go after each run\n"
+    "  --huge-pages   like --arena, with the arena backed by transparent huge pages\n"
+    "  --cache DIR    reuse answers stored in DIR for inputs with the same contents, and\n"
+    "                 store new ones. Each build of the runner keeps its own answers\n"
+    "  --embedded     answer days 6, 7 and 9 with what the compiler solved from their\n"
+    "                 embedded input (requires a build with AOC_EMBED_INPUTS)\n"
+    "\n"
+    "Batch mode:\n"
+    "  --batch PATH   solve every input in a directory (files named dayN*) or listed in a\n"
+    "                 manifest (`[DAY] PATH` per line) in one process, in parallel, and\n"
+    "                 report one line per file with its answers and timings; --day N keeps\n"
+    "                 only the inputs of day N. Inputs always parse into reused arenas.\n"
+    "                 Exits with 1 if any input failed\n"
+    "  --format FMT   `csv` (default) or `json` (one object per line)\n"
+    "  --output PATH  write the report to PATH instead of stdout\n"
+    "\n"
+    "Server mode:\n"
+    "  --serve        answer `DAY [PATH]` requests from stdin with one JSON line each, which\n"
+    "                 holds the answers and latencies. Inputs stay parsed between requests\n"
+    "                 and are parsed again when the file changes. `quit` or the end of the\n"
+    "                 input stops the server\n"
+    "  --socket PATH  same, for any number of clients of a Unix domain socket at PATH\n"
+    "\n"
+    "Benchmark mode:\n"
+    "  --bench N      time N end-to-end runs of each day and report their distribution\n"
+    "  --warmup N     untimed runs before the first timed one (default 3)\n"
+    "  --json PATH    also write every sample and the summary to PATH\n"
+    "  --save-baseline PATH\n"
+    "                 save every phase's samples to PATH for a later `--baseline`\n"
+    "  --baseline PATH\n"
+    "                 compare each phase against the samples saved in PATH, exits with 2\n"
+    "                 when one got significantly slower by more than the threshold\n"
+    "  --threshold PCT\n"
+    "                 slowdown in percent that counts as a regression (default 5)\n"
+};
+
+struct Options {
+    std::vector<aoc::u32> days{};
+    std::optional<std::filesystem::path> input{};
+    aoc::u32 repeat{1};
+    std::optional<aoc::u32> threads{};
+    aoc::u32 bench{};
+    aoc::u32 warmup{3};
+    std::optional<std::filesystem::path> json{};
+    std::optional<std::filesystem::path> save_baseline{};
+    std::optional<std::filesystem::path> baseline{};
+    aoc::u32 threshold{5};
+    std::optional<std::filesystem::path> batch{};
+    runner::BatchFormat format{runner::BatchFormat::Csv};
+    std::optional<std::filesystem::path> output{};
+    std::optional<std::filesystem::path> socket{};
+    std::optional<std::filesystem::path> cache{};
+    bool serve{};
+    bool pipeline{};
+    bool embedded{};
+    bool arena{};
+    bool huge_pages{};
+    bool all{};
+    bool help{};
+};
+
+struct Job {
+    const runner::Day* day{};
+    std::filesystem::path input{};
+    runner::Answers answers{};
+    // run times in benchmark mode, `dayN/total` for end-to-end runs and one series per phase
+    runner::SampleSet samples{};
+};
+
+std::optional<aoc::u32> parse_number(std::string_view s) {
+    aoc::u32 value{};
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+    if (ec != std::errc{} || ptr != s.data() + s.size()) {
+        return {};
+    }
+    return value;
+}
+
+template<typename... Args>
+void error(fmt::format_string<Args...> fmt, Args&&... args) {
+    fmt::print(stderr, "error: {}\n\n{}", fmt::format(fmt, std::forward<Args>(args)...), USAGE);
+}
+
+std::optional<Options> parse_args(std::span<char*> args) {
+    Options opts{};
+
+    for (size_t i = 1; i < args.size(); ++i) {
+        std::string_view arg{args[i]};
+        if (arg == "-h" || arg == "--help") {
+            opts.help = true;
+            return opts;
+        }
+        if (arg == "--all") {
+            opts.all = true;
+            continue;
+        }
+        if (arg == "--pipeline") {
+            opts.pipeline = true;
+            continue;
+        }
+        if (arg == "--embedded") {
+            opts.embedded = true;
+            continue;
+        }
+        if (arg == "--serve") {
+            opts.serve = true;
+            continue;
+        }
+        if (arg == "--arena") {
+            opts.arena = true;
+            continue;
+        }
+        if (arg == "--huge-pages") {
+            opts.arena = true;
+            opts.huge_pages = true;
+            continue;
+        }
+
+        if (i + 1 >= args.size()) {
+            error("unknown option or missing value: `{}`", arg);
+            return {};
+        }
+        std::string_view value{args[++i]};
+
+        if (arg == "--input") {
+            opts.input = value;
+            continue;
+        }
+        if (arg == "--json") {
+            opts.json = value;
+            continue;
+        }
+        if (arg == "--save-baseline") {
+            opts.save_baseline = value;
+            continue;
+        }
+        if (arg == "--baseline") {
+            opts.baseline = value;
+            continue;
+        }
+        if (arg == "--batch") {
+            opts.batch = value;
+            continue;
+        }
+        if (arg == "--socket") {
+            opts.socket = value;
+            continue;
+        }
+        if (arg == "--cache") {
+            opts.cache = value;
+            continue;
+        }
+        if (arg == "--output") {
+            opts.output = value;
+            continue;
+        }
+        if (arg == "--format") {
+            if (value == "csv") {
+                opts.format = runner::BatchFormat::Csv;
+            } else if (value == "json") {
+                opts.format = runner::BatchFormat::Json;
+            } else {
+                error("`--format` expects `csv` or `json`, got `{}`", value);
+                return {};
+            }
+            continue;
+        }
+
+        auto num = parse_number(value);
+        if (!num.has_value()) {
+            error("`{}` expects a number, got `{}`", arg, value);
+            return {};
+        }
+        if (arg == "--day") {
+            opts.days.push_back(*num);
+        } else if (arg == "--repeat") {
+            opts.repeat = std::max(*num, aoc::u32{1});
+        } else if (arg == "--threads") {
+            opts.threads = *num;
+        } else if (arg == "--bench") {
+            opts.bench = *num;
+        } else if (arg == "--warmup") {
+            opts.warmup = *num;
+        } else if (arg == "--threshold") {
+            opts.threshold = *num;
+        } else {
+            error("unknown option: `{}`", arg);
+            return {};
+        }
+    }
+
+    if (opts.bench > 0 && opts.repeat > 1) {
+        error("`--repeat` and `--bench` cannot be combined");
+        return {};
+    }
+    if (opts.bench > 0 && opts.cache.has_value()) {
+        error("`--cache` and `--bench` cannot be combined, the samples would time the cache");
+        return {};
+    }
+    auto reports = opts.json.has_value() || opts.save_baseline.has_value()
+        || opts.baseline.has_value();
+    if (reports && opts.bench == 0) {
+        error("`--json`, `--save-baseline` and `--baseline` require `--bench`");
+        return {};
+    }
+    if (opts.embedded && opts.input.has_value()) {
+        error("`--embedded` answers the embedded inputs, it cannot be combined with `--input`");
+        return {};
+    }
+#if !AOC_EMBED_INPUTS
+    if (opts.embedded) {
+        error("`--embedded` requires a build configured with `-DAOC_EMBED_INPUTS=ON`");
+        return {};
+    }
+#endif
+    auto single_runs = opts.all || opts.input.has_value() || opts.repeat > 1 || opts.bench > 0;
+    if (opts.batch.has_value() && (single_runs || opts.embedded)) {
+        error(
+            "`--batch` cannot be combined with `--all`, `--input`, `--repeat`, `--bench` or "
+            "`--embedded`"
+        );
+        return {};
+    }
+    auto server = opts.serve || opts.socket.has_value();
+    auto runs = single_runs || opts.batch.has_value() || opts.cache.has_value() || opts.embedded;
+    if (server && (runs || !opts.days.empty())) {
+        error("`--serve` and `--socket` only take `--threads`");
+        return {};
+    }
+    if (opts.serve && opts.socket.has_value()) {
+        error("`--serve` and `--socket` cannot be combined");
+        return {};
+    }
+    if (!opts.batch.has_value() && opts.output.has_value()) {
+        error("`--output` requires `--batch`");
+        return {};
+    }
+
+    return opts;
+}
+
+// resolves the requested days to jobs, in day order without duplicates
+std::optional<std::vector<Job>> make_jobs(const Options& opts) {
+    std::vector<aoc::u32> numbers{opts.days};
+    if (opts.all) {
+        for (const auto& day : runner::days()) {
+            numbers.push_back(day.number);
+        }
+    }
+    std::ranges::sort(numbers);
+    auto [first, last] = std::ranges::unique(numbers);
+    numbers.erase(first, last);
+
+    if (numbers.empty()) {
+        error("no days selected, use `--day N` or `--all`");
+        return {};
+    }
+    if (opts.input.has_value() && numbers.size() != 1) {
+        error("`--input` can only be used with a single day");
+        return {};
+    }
+
+    std::vector<Job> jobs{};
+    for (auto n : numbers) {
+        const auto* day = runner::find_day(n);
+        if (day == nullptr) {
+            error("day {} is not implemented", n);
+            return {};
+        }
+
+        auto input = opts.input.value_or(day->default_input());
+        if (!std::filesystem::exists(input)) {
+            error("input file `{}` does not exist", input.string());
+            return {};
+        }
+        jobs.push_back({day, std::move(input)});
+    }
+    return jobs;
+}
+
+// Solves a day `repeat` times, or in benchmark mode, `warmup` times and then `bench` timed
+// times. The warmup runs fill the page cache and let the allocator settle, so the samples
+// show steady state end-to-end times. With `--arena`, each job has its own arena, which is
+// reset after every run. With `--cache`, each run looks up its answers in `cache` first, and
+// with `--embedded`, days solved at compile time only return their answers.
+void run_job(Job& job, const Options& opts, const runner::ResultCache* cache) {
+    const auto& solve =
+        opts.pipeline && job.day->pipelined ? job.day->pipelined : job.day->run;
+    std::optional<aoc::Arena> arena{};
+    if (opts.arena) {
+        arena.emplace(aoc::ArenaOptions{.huge_pages = opts.huge_pages});
+    }
+    auto* mr = arena.has_value() ? &*arena : std::pmr::get_default_resource();
+    auto solve_once = [&] {
+        if (opts.embedded && job.day->embedded) {
+            return job.day->embedded();
+        }
+        auto answers = solve(job.input, mr);
+        if (arena.has_value()) {
+            arena->reset();
+        }
+        return answers;
+    };
+    auto run = [&] {
+        return cache != nullptr ? cache->solve(*job.day, job.input, solve_once) : solve_once();
+    };
+
+    if (opts.bench == 0) {
+        for (aoc::u32 r = 0; r < opts.repeat; ++r) {
+            job.answers = run();
+        }
+        return;
+    }
+
+    for (aoc::u32 r = 0; r < opts.warmup; ++r) {
+        job.answers = run();
+    }
+    auto prefix = fmt::format("day{}/", job.day->number);
+    for (aoc::u32 r = 0; r < opts.bench; ++r) {
+        auto start = aoc::Clock::now();
+        job.answers = run();
+        std::chrono::duration<aoc::f64, std::nano> elapsed = aoc::Clock::now() - start;
+
+        job.samples.add(prefix + "total", elapsed.count());
+        for (const auto& phase : job.answers.timings) {
+            std::chrono::duration<aoc::f64, std::nano> ns = phase.elapsed;
+            job.samples.add(prefix + std::string{phase.name}, ns.count());
+        }
+    }
+}
+
+// Days run one at a time unless `--threads` is given, then they are spread over the shared
+// pool. Either way, their own parallel loops use that pool too.
+void run_jobs(std::vector<Job>& jobs, const Options& opts, const runner::ResultCache* cache) {
+    if (!opts.threads.has_value()) {
+        for (auto& job : jobs) {
+            run_job(job, opts, cache);
+        }
+        return;
+    }
+    aoc::parallel_for(0, jobs.size(), [&](size_t i) { run_job(jobs[i], opts, cache); }, 1);
+}
+
+struct PhaseAllocs {
+    aoc::f64 count{};
+    aoc::u64 bytes{};
+    aoc::u64 peak{};
+};
+
+// Allocations per call of a phase, with the highest peak of any call, in builds with
+// `AOC_TRACK_ALLOCS`. They come from the phase registry, so warmup runs count too, and only
+// the thread running the phase is counted. `dayN/total` has no phase of its own.
+std::optional<PhaseAllocs> phase_allocs(std::string_view name) {
+    if (!aoc::alloc_tracking_enabled()) {
+        return {};
+    }
+    auto phase = aoc::PhaseRegistry::instance().find(name);
+    if (!phase.has_value() || phase->calls == 0) {
+        return {};
+    }
+    const auto& allocs = phase->allocs;
+    return PhaseAllocs{
+        static_cast<aoc::f64>(allocs.count) / static_cast<aoc::f64>(phase->calls),
+        allocs.bytes / phase->calls,
+        allocs.peak,
+    };
+}
+
+void print_distributions(const std::vector<Job>& jobs) {
+    auto tracking = aoc::alloc_tracking_enabled();
+    aoc::usize width = 5;
+    for (const auto& job : jobs) {
+        for (const auto& [name, _] : job.samples) {
+            width = std::max(width, name.size());
+        }
+    }
+
+    fmt::println(
+        "\n{:<{}} {:>6} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10}{}",
+        "phase",
+        width,
+        "runs",
+        "outliers",
+        "min",
+        "median",
+        "p90",
+        "p99",
+        "max",
+        "mean",
+        "stddev",
+        tracking ? fmt::format(" {:>11} {:>10} {:>10}", "allocs/call", "bytes/call", "peak") : ""
+    );
+    for (const auto& job : jobs) {
+        for (const auto& [name, samples] : job.samples) {
+            auto d = aoc::describe(samples);
+            std::string allocs{};
+            if (auto a = phase_allocs(name)) {
+                allocs = fmt::format(
+                    " {:>11.1f} {:>10} {:>10}",
+                    a->count,
+                    aoc::format_bytes(a->bytes),
+                    aoc::format_bytes(a->peak)
+                );
+            } else if (tracking) {
+                allocs = fmt::format(" {:>11} {:>10} {:>10}", "-", "-", "-");
+            }
+            fmt::println(
+                "{:<{}} {:>6} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10}{}",
+                name,
+                width,
+                d.samples,
+                d.outliers,
+                aoc::format_nanos(d.min),
+                aoc::format_nanos(d.median),
+                aoc::format_nanos(d.p90),
+                aoc::format_nanos(d.p99),
+                aoc::format_nanos(d.max),
+                aoc::format_nanos(d.mean),
+                aoc::format_nanos(d.stddev),
+                allocs
+            );
+        }
+    }
+}
+
+void write_json(std::ostream& os, const std::vector<Job>& jobs, const Options& opts) {
+    os << "{\"warmup\":" << opts.warmup << ",\"runs\":" << opts.bench
+       << ",\"threads\":" << aoc::ThreadPool::global().size() << ",\"days\":[";
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const auto& job = jobs[i];
+        os << (i == 0 ? "" : ",") << "{\"day\":" << job.day->number
+           << fmt::format(",\"input\":{:?}", job.input.generic_string()) << ",\"phases\":[";
+
+        bool first{true};
+        for (const auto& [name, samples] : job.samples) {
+            auto d = aoc::describe(samples);
+            os << (first ? "" : ",") << fmt::format("{{\"name\":{:?}", name)
+               << fmt::format(
+                      ",\"min_ns\":{:.0f},\"median_ns\":{:.0f},\"p90_ns\":{:.0f},"
+                      "\"p99_ns\":{:.0f},\"max_ns\":{:.0f},\"mean_ns\":{:.0f},"
+                      "\"stddev_ns\":{:.0f},\"outliers\":{}",
+                      d.min,
+                      d.median,
+                      d.p90,
+                      d.p99,
+                      d.max,
+                      d.mean,
+                      d.stddev,
+                      d.outliers
+                  );
+            if (auto a = phase_allocs(name)) {
+                os << fmt::format(
+                    ",\"allocs_per_call\":{:.1f},\"bytes_per_call\":{},\"peak_bytes\":{}",
+                    a->count,
+                    a->bytes,
+                    a->peak
+                );
+            }
+            os << fmt::format(",\"samples_ns\":[{:.0f}]}}", fmt::join(samples, ","));
+            first = false;
+        }
+        os << "]}";
+    }
+    os << "]}\n";
+}
+
+// Solves every input of `--batch` and writes the report, returns the exit code.
+int run_batch_mode(const Options& opts, const runner::ResultCache* cache) {
+    auto inputs = runner::find_batch_inputs(*opts.batch, opts.days);
+    if (!inputs.has_value()) {
+        return 1;
+    }
+    if (inputs->empty()) {
+        spdlog::error("No inputs of a registered day in `{}`", opts.batch->string());
+        return 1;
+    }
+
+    // the days log while they solve, which would bury the report
+    spdlog::set_level(spdlog::level::warn);
+    // a malformed input is reported in its row instead of ending the batch
+    aoc::set_panics_throw(true);
+    aoc::ThreadPool::set_global_threads(opts.threads.value_or(0));
+    auto start = aoc::Clock::now();
+    auto results = runner::run_batch(*inputs, opts.pipeline, cache);
+    std::chrono::duration<aoc::f64, std::nano> elapsed = aoc::Clock::now() - start;
+
+    if (opts.output.has_value()) {
+        std::ofstream out{*opts.output};
+        if (!out) {
+            spdlog::error("Failed to write batch report to `{}`", opts.output->string());
+            return 1;
+        }
+        runner::write_batch(out, *inputs, results, opts.format);
+    } else {
+        runner::write_batch(std::cout, *inputs, results, opts.format);
+    }
+
+    auto failed = std::ranges::count_if(results, [](const auto& r) { return !r.error.empty(); });
+    fmt::print(
+        stderr,
+        "Solved {} inputs in {} on {} threads, {} failed\n",
+        inputs->size(),
+        aoc::format_nanos(elapsed.count()),
+        aoc::ThreadPool::global().size(),
+        failed
+    );
+    return failed > 0 ? 1 : 0;
+}
+
+// Answers requests until a client sends `quit` (or stdin ends), returns the exit code.
+int run_server(const Options& opts) {
+    aoc::ThreadPool::set_global_threads(opts.threads.value_or(0));
+    // a request for a malformed input gets an error instead of taking the server down
+    aoc::set_panics_throw(true);
+    runner::Server server{};
+    if (opts.socket.has_value()) {
+        return runner::serve_socket(server, *opts.socket) ? 0 : 1;
+    }
+
+    // logs share stdout with the responses
+    spdlog::set_level(spdlog::level::off);
+    server.serve(std::cin, std::cout);
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    aoc::init_logging(spdlog::level::info);
+
+    auto opts = parse_args({argv, static_cast<size_t>(argc)});
+    if (!opts.has_value()) {
+        return 1;
+    }
+    if (opts->help) {
+        fmt::print("{}", USAGE);
+        return 0;
+    }
+    if (opts->serve || opts->socket.has_value()) {
+        return run_server(*opts);
+    }
+    std::optional<runner::ResultCache> cache{};
+    if (opts->cache.has_value()) {
+        cache = runner::ResultCache::open(*opts->cache, argv[0]);
+        if (!cache.has_value()) {
+            return 1;
+        }
+    }
+    const auto* cache_ptr = cache.has_value() ? &*cache : nullptr;
+    if (opts->batch.has_value()) {
+        return run_batch_mode(*opts, cache_ptr);
+    }
+    auto jobs = make_jobs(*opts);
+    if (!jobs.has_value()) {
+        return 1;
+    }
+
+    aoc::ThreadPool::set_global_threads(opts->threads.value_or(0));
+    run_jobs(*jobs, *opts, cache_ptr);
+
+    for (const auto& job : *jobs) {
+        fmt::println("Day {}", job.day->number);
+        fmt::println("  Part 1: {}", job.answers.part1);
+        if (job.answers.part2.has_value()) {
+            fmt::println("  Part 2: {}", *job.answers.part2);
+        }
+    }
+
+    if (opts->bench == 0) {
+        return 0;
+    }
+    print_distributions(*jobs);
+
+    if (opts->json.has_value()) {
+        std::ofstream out{*opts->json};
+        if (!out) {
+            spdlog::error("Failed to write benchmark report to `{}`", opts->json->string());
+            return 1;
+        }
+        write_json(out, *jobs, *opts);
+    }
+
+    runner::SampleSet samples{};
+    for (const auto& job : *jobs) {
+        samples.merge(job.samples);
+    }
+    if (opts->save_baseline.has_value() && !runner::save_baseline(*opts->save_baseline, samples)) {
+        return 1;
+    }
+    if (opts->baseline.has_value()) {
+        auto baseline = runner::load_baseline(*opts->baseline);
+        if (!baseline.has_value()) {
+            return 1;
+        }
+        auto threshold = static_cast<aoc::f64>(opts->threshold) / 100.0;
+        auto regressions = runner::compare_baseline(*baseline, samples, threshold);
+        if (regressions > 0) {
+            spdlog::error(
+                "{} phase(s) slowed down by more than {}% against `{}`",
+                regressions,
+                opts->threshold,
+                opts->baseline->string()
+            );
+            return 2;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#include "registry.hpp"
+
+#include "day1.hpp"
+#include "day10.hpp"
+#include "day11.hpp"
+#include "day2.hpp"
+#include "day3.hpp"
+#include "day4.hpp"
+#include "day5.hpp"
+#include "day6.hpp"
+#include "day7.hpp"
+#include "day8.hpp"
+#include "day9.hpp"
+
+#include <algorithm>
+
+#if AOC_EMBED_INPUTS
+#  include "aoc_inputs.hpp"
+#endif
+
+namespace runner {
+
+namespace {
+    // Adds answers for `data/dayN.txt` computed at compile time by a day's
+    // `solve_constexpr(input)`, in builds with `AOC_EMBED_INPUTS`. They are recorded as the
+    // `dayN/embedded` phase. Other builds leave the day as it is.
+    //
+    // `solve_constexpr` solves both parts straight from the input text, and everything it
+    // calls is `constexpr`, so the compiler computes the answers while this file builds. The
+    // input is embedded byte for byte, so it trims every line to also accept CRLF checkouts.
+    template<aoc::u32 Number, auto Solve>
+    Day with_embedded(Day day) {
+        AOC_ASSERT(day.number == Number, "Embedded answers must be for the same day");
+#if AOC_EMBED_INPUTS
+        static_assert(!aoc::inputs::get(Number).empty(), "Input of the day was not embedded");
+        static constexpr auto ANSWERS = Solve(aoc::inputs::get(Number));
+        day.embedded = [] {
+            Answers answers{};
+            const auto bytes = aoc::inputs::get(Number).size();
+            aoc::ScopedTimer timer{fmt::format("day{}/embedded", Number), bytes};
+            answers.part1 = fmt::to_string(ANSWERS.first);
+            answers.part2 = fmt::to_string(ANSWERS.second);
+            answers.timings.push_back({"embedded", timer.elapsed()});
+            return answers;
+        };
+#endif
+        return day;
+    }
+}  // namespace
+
+const std::vector<Day>& days() {
+    static const std::vector<Day> registry{
+        make_day<day1::parse, day1::part1>(1),
+        with_pipeline<day2::solve_pipelined>(make_day<day2::parse, day2::part1, day2::part2>(2)),
+        make_day<day3::parse, day3::part1, day3::part2>(3),
+        with_pipeline<day4::solve_pipelined>(make_day<day4::parse, day4::part1, day4::part2>(4)),
+        make_concurrent_day<day5::parse, day5::part1, day5::part2>(5),
+        with_embedded<6, day6::solve_constexpr>(
+            make_concurrent_day<day6::parse, day6::part1, day6::part2>(6)
+        ),
+        with_embedded<7, day7::solve_constexpr>(with_pipeline<day7::solve_pipelined>(
+            make_concurrent_day<day7::parse, day7::part1, day7::part2>(7)
+        )),
+        make_concurrent_day<day8::parse, day8::part1, day8::part2>(8),
+        with_embedded<9, day9::solve_constexpr>(with_pipeline<day9::solve_pipelined>(
+            make_day<day9::parse, day9::part1, day9::part2>(9)
+        )),
+        make_day<day10::parse, day10::part1, day10::part2>(10),
+        make_day<day11::parse, day11::part1, day11::part2>(11),
+    };
+    return registry;
+}
+
+const Day* find_day(aoc::u32 number) {
+    const auto& registry = days();
+    auto it = std::ranges::find(registry, number, &Day::number);
+    return it == registry.end() ? nullptr : &*it;
+}
+
+}  // namespace runner
@@ -0,0 +1,332 @@
+#include "server.hpp"
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <sys/socket.h>
+#  include <sys/un.h>
+#  include <unistd.h>
+#endif
+
+namespace runner {
+
+namespace {
+    aoc::f64 to_nanos(aoc::Clock::duration d) {
+        return std::chrono::duration<aoc::f64, std::nano>{d}.count();
+    }
+
+    std::string error_response(std::string_view message) {
+        return fmt::format("{{\"error\":{:?}}}", message);
+    }
+
+    std::string response(
+        aoc::u32 day,
+        const std::filesystem::path& path,
+        const Answers& answers,
+        bool cached,
+        aoc::Clock::duration parse_time,
+        aoc::Clock::duration solve_time
+    ) {
+        auto s = fmt::format(
+            "{{\"day\":{},\"input\":{:?},\"part1\":{:?}", day, path.generic_string(), answers.part1
+        );
+        if (answers.part2.has_value()) {
+            s += fmt::format(",\"part2\":{:?}", *answers.part2);
+        }
+        s += fmt::format(
+            ",\"cached\":{},\"parse_ns\":{:.0f},\"solve_ns\":{:.0f},\"phases\":{{",
+            cached,
+            to_nanos(parse_time),
+            to_nanos(solve_time)
+        );
+        for (aoc::usize i = 0; i < answers.timings.size(); ++i) {
+            const auto& phase = answers.timings[i];
+            s += fmt::format(
+                "{}{:?}:{:.0f}", i == 0 ? "" : ",", phase.name, to_nanos(phase.elapsed)
+            );
+        }
+        return s + "}}";
+    }
+}  // namespace
+
+std::string Server::handle(std::string_view request, bool& stop) {
+    auto line = aoc::trim(request);
+    if (line.empty()) {
+        return {};
+    }
+    if (line == "quit") {
+        stop = true;
+        return {};
+    }
+
+    using Fields = std::pair<std::string_view, std::string_view>;
+    auto [daystr, pathstr] = aoc::split_once(line, ' ').value_or(Fields{line, {}});
+    aoc::u32 number{};
+    auto [ptr, ec] = std::from_chars(daystr.data(), daystr.data() + daystr.size(), number);
+    if (ec != std::errc{} || ptr != daystr.data() + daystr.size()) {
+        return error_response(fmt::format("expected `DAY [PATH]`, got `{}`", line));
+    }
+    const auto* day = find_day(number);
+    if (day == nullptr) {
+        return error_response(fmt::format("day {} is not implemented", number));
+    }
+    pathstr = aoc::trim(pathstr);
+    auto path = pathstr.empty() ? day->default_input() : std::filesystem::path{pathstr};
+
+    try {
+        bool parsed{};
+        auto entry = load(*day, path, parsed);
+        auto start = aoc::Clock::now();
+        auto answers = entry->solve();
+        auto solve_time = aoc::Clock::now() - start;
+        auto parse_time = parsed ? entry->parse_time : aoc::Clock::duration{};
+        return response(number, path, answers, !parsed, parse_time, solve_time);
+    } catch (const std::exception& e) {
+        return error_response(e.what());
+    }
+}
+
+bool Server::serve(std::istream& in, std::ostream& out) {
+    std::string line{};
+    while (std::getline(in, line)) {
+        bool stop{};
+        auto answer = handle(line, stop);
+        if (stop) {
+            return false;
+        }
+        if (!answer.empty()) {
+            out << answer << '\n' << std::flush;
+        }
+    }
+    return true;
+}
+
+aoc::usize Server::cached() const {
+    std::lock_guard lock{_mutex};
+    return _entries.size();
+}
+
+std::shared_ptr<const Server::Entry> Server::load(
+    const Day& day,
+    const std::filesystem::path& path,
+    bool& parsed
+) {
+    // throws for missing files, which the request reports
+    auto modified = std::filesystem::last_write_time(path);
+    auto size = std::filesystem::file_size(path);
+    auto key = std::pair{day.number, std::filesystem::absolute(path).lexically_normal()};
+
+    // The first request for a version of the file puts a future in its slot and parses it
+    // without holding the lock, so other files are served meanwhile. Requests for the same
+    // version wait on that future, so it is still parsed only once.
+    std::promise<std::shared_ptr<const Entry>> promise{};
+    std::shared_future<std::shared_ptr<const Entry>> pending{};
+    {
+        std::lock_guard lock{_mutex};
+        auto it = _entries.find(key);
+        if (it != _entries.end() && it->second.modified == modified && it->second.size == size) {
+            pending = it->second.entry;
+        } else {
+            // requests still solving the old input keep it alive until they finish
+            _entries.insert_or_assign(key, Slot{modified, size, promise.get_future().share()});
+        }
+    }
+    if (pending.valid()) {
+        // waits if another request is still parsing it, and rethrows its parse error
+        return pending.get();
+    }
+
+    try {
+        auto entry = std::make_shared<Entry>();
+        entry->arena = std::make_unique<aoc::Arena>();
+        auto start = aoc::Clock::now();
+        entry->solve = day.load(path, entry->arena.get());
+        entry->parse_time = aoc::Clock::now() - start;
+
+        promise.set_value(entry);
+        parsed = true;
+        return entry;
+    } catch (...) {
+        // the next request tries again, the ones already waiting get this error
+        {
+            std::lock_guard lock{_mutex};
+            auto it = _entries.find(key);
+            if (it != _entries.end() && it->second.modified == modified
+                && it->second.size == size) {
+                _entries.erase(it);
+            }
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+namespace {
+    // a client hanging up mid-response must not raise SIGPIPE and kill the server. macOS has
+    // no `MSG_NOSIGNAL`, it gets `SO_NOSIGPIPE` on each client socket instead
+#  if defined(MSG_NOSIGNAL)
+    constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#  else
+    constexpr int SEND_FLAGS = 0;
+#  endif
+
+    bool send_all(int fd, std::string_view data) {
+        while (!data.empty()) {
+            auto sent = send(fd, data.data(), data.size(), SEND_FLAGS);
+            if (sent <= 0) {
+                return false;
+            }
+            data.remove_prefix(static_cast<aoc::usize>(sent));
+        }
+        return true;
+    }
+
+    // serves one client until it disconnects, returns true if it sent `quit`
+    bool serve_connection(Server& server, int fd) {
+        std::string buffer{};
+        std::array<char, 4096> chunk{};
+        while (true) {
+            auto n = recv(fd, chunk.data(), chunk.size(), 0);
+            if (n <= 0) {
+                return false;
+            }
+            buffer.append(chunk.data(), static_cast<aoc::usize>(n));
+
+            for (auto end = buffer.find('\n'); end != std::string::npos;
+                 end = buffer.find('\n')) {
+                auto line = buffer.substr(0, end);
+                buffer.erase(0, end + 1);
+
+                bool stop{};
+                auto answer = server.handle(line, stop);
+                if (stop) {
+                    return true;
+                }
+                if (!answer.empty() && !send_all(fd, answer + '\n')) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    sockaddr_un socket_address(const std::filesystem::path& path) {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        path.native().copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+        return addr;
+    }
+}  // namespace
+
+bool serve_socket(Server& server, const std::filesystem::path& path) {
+    auto addr = socket_address(path);
+    if (path.native().size() >= sizeof(addr.sun_path)) {
+        spdlog::error("Socket path `{}` is too long", path.string());
+        return false;
+    }
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener == -1) {
+        spdlog::error("Failed to create a Unix socket");
+        return false;
+    }
+    // a socket file left over from an earlier run would make `bind` fail
+    std::error_code ignored{};
+    std::filesystem::remove(path, ignored);
+    // NOLINTNEXTLINE(*-reinterpret-cast): the sockets API takes a generic address
+    auto* generic = reinterpret_cast<const sockaddr*>(&addr);
+    if (bind(listener, generic, sizeof(addr)) == -1 || listen(listener, SOMAXCONN) == -1) {
+        spdlog::error("Failed to listen on `{}`", path.string());
+        close(listener);
+        return false;
+    }
+    spdlog::info("Listening on `{}`", path.string());
+
+    std::atomic<bool> stop{};
+    bool failed{};
+    // open connections, each thread closes and removes its own when the client is done
+    std::mutex clients_mutex{};
+    std::condition_variable clients_closed{};
+    std::vector<int> clients{};
+    while (true) {
+        int client = accept(listener, nullptr, nullptr);
+        if (stop.load()) {
+            if (client != -1) {
+                close(client);
+            }
+            break;
+        }
+        if (client == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // e.g. out of file descriptors, where retrying right away would only spin
+            auto error = std::error_code{errno, std::generic_category()};
+            spdlog::error(
+                "Failed to accept a connection on `{}`: {}", path.string(), error.message()
+            );
+            failed = true;
+            break;
+        }
+#  if defined(SO_NOSIGPIPE)
+        int on = 1;
+        setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#  endif
+
+        std::lock_guard lock{clients_mutex};
+        clients.push_back(client);
+        try {
+            // detached, so finished connections do not pile up. waiting for `clients` to
+            // empty below keeps the locals they use alive
+            std::thread{[&, client] {
+                if (serve_connection(server, client) && !stop.exchange(true)) {
+                    // wakes up `accept` with a connection of our own
+                    int wake = socket(AF_UNIX, SOCK_STREAM, 0);
+                    connect(wake, generic, sizeof(addr));
+                    close(wake);
+                }
+                std::lock_guard done{clients_mutex};
+                std::erase(clients, client);
+                close(client);
+                clients_closed.notify_all();
+            }}.detach();
+        } catch (const std::system_error& e) {
+            spdlog::error("Failed to start a thread for a connection: {}", e.what());
+            clients.pop_back();
+            close(client);
+        }
+    }
+
+    // ends the connections still open, their threads return once `recv` fails
+    {
+        std::unique_lock lock{clients_mutex};
+        for (auto fd : clients) {
+            shutdown(fd, SHUT_RDWR);
+        }
+        clients_closed.wait(lock, [&clients] { return clients.empty(); });
+    }
+    close(listener);
+    std::filesystem::remove(path, ignored);
+    return !failed;
+}
+
+#else
+
+bool serve_socket(Server& /*server*/, const std::filesystem::path& /*path*/) {
+    spdlog::error("Unix domain sockets are not supported on this platform, use `--serve`");
+    return false;
+}
+
+#endif
+
+}  // namespace runner
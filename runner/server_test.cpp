@@ -0,0 +1,143 @@
+#include "server.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <latch>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// input file named after the running test
+std::filesystem::path test_input() {
+    const auto* test = testing::UnitTest::GetInstance()->current_test_info();
+    return std::filesystem::temp_directory_path()
+        / (std::string{"aoc_server_"} + test->name() + ".txt");
+}
+
+void write_file(const std::filesystem::path& path, std::string_view contents) {
+    std::ofstream out{path, std::ios::binary};
+    out << contents;
+}
+
+std::string request(runner::Server& server, aoc::u32 day, const std::filesystem::path& path) {
+    bool stop{};
+    auto answer = server.handle(fmt::format("{} {}", day, path.string()), stop);
+    EXPECT_FALSE(stop);
+    return answer;
+}
+
+bool parsed(std::string_view response) {
+    return response.find("\"cached\":false") != std::string_view::npos;
+}
+
+}  // namespace
+
+TEST(RunnerServer, Requests) {
+    runner::Server server{};
+    bool stop{};
+    EXPECT_EQ(server.handle("  ", stop), "");
+    EXPECT_FALSE(stop);
+    EXPECT_EQ(server.handle("five", stop), R"({"error":"expected `DAY [PATH]`, got `five`"})");
+    EXPECT_EQ(server.handle("99", stop), R"({"error":"day 99 is not implemented"})");
+    EXPECT_EQ(server.handle("quit", stop), "");
+    EXPECT_TRUE(stop);
+}
+
+TEST(RunnerServer, ReloadsChangedInput) {
+    auto path = test_input();
+    write_file(path, "0 3 6 9 12 15\n");
+
+    runner::Server server{};
+    auto first = request(server, 9, path);
+    EXPECT_TRUE(parsed(first)) << first;
+    EXPECT_NE(first.find(R"("part1":"18","part2":"-3")"), std::string::npos) << first;
+    EXPECT_FALSE(parsed(request(server, 9, path)));
+
+    // a different size
+    write_file(path, "1 3 6 10 15 21\n");
+    auto resized = request(server, 9, path);
+    EXPECT_TRUE(parsed(resized));
+    EXPECT_NE(resized.find(R"("part1":"28","part2":"0")"), std::string::npos) << resized;
+
+    // the same size, only a newer modification time
+    auto modified = std::filesystem::last_write_time(path);
+    std::filesystem::last_write_time(path, modified + std::chrono::seconds{1});
+    EXPECT_TRUE(parsed(request(server, 9, path)));
+    EXPECT_FALSE(parsed(request(server, 9, path)));
+    EXPECT_EQ(server.cached(), 1);
+
+    std::filesystem::remove(path);
+}
+
+TEST(RunnerServer, ParsesOnceForConcurrentRequests) {
+    auto path = test_input();
+    std::string input{};
+    for (int i = 0; i < 20'000; ++i) {
+        input += "1 2 3 4 5 6 7 8 9 10\n";
+    }
+    write_file(path, input);
+
+    runner::Server server{};
+    constexpr aoc::usize THREADS{8};
+    std::vector<std::string> responses(THREADS);
+    {
+        std::latch start{THREADS};
+        std::vector<std::jthread> threads{};
+        for (aoc::usize i = 0; i < THREADS; ++i) {
+            threads.emplace_back([&, i] {
+                start.arrive_and_wait();
+                responses[i] = request(server, 9, path);
+            });
+        }
+    }
+
+    EXPECT_EQ(std::ranges::count_if(responses, parsed), 1);
+    for (const auto& response : responses) {
+        EXPECT_NE(response.find("\"part1\":\"220000\""), std::string::npos) << response;
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(RunnerServer, RetriesAfterParseError) {
+    auto path = test_input();
+    write_file(path, "1 2 x\n");
+    auto modified = std::filesystem::last_write_time(path);
+
+    runner::Server server{};
+    auto failed = request(server, 9, path);
+    EXPECT_TRUE(failed.starts_with(R"({"error":)")) << failed;
+    EXPECT_EQ(server.cached(), 0);
+
+    // same size and modification time, so only a failed parse that was not kept can see it
+    write_file(path, "1 2 3\n");
+    std::filesystem::last_write_time(path, modified);
+    auto fixed = request(server, 9, path);
+    EXPECT_TRUE(parsed(fixed)) << fixed;
+    EXPECT_NE(fixed.find(R"("part1":"4","part2":"0")"), std::string::npos) << fixed;
+
+    std::filesystem::remove(path);
+}
+
+TEST(RunnerServer, SurvivesPanics) {
+    auto path = test_input();
+    write_file(path, "XYZ 5\n");
+
+    aoc::set_panics_throw(true);
+    runner::Server server{};
+    auto failed = request(server, 7, path);
+    aoc::set_panics_throw(false);
+    EXPECT_NE(failed.find("unknown card"), std::string::npos) << failed;
+
+    write_file(path, "32T3K 765\nT55J5 684\nKK677 28\nKTJJT 220\nQQQJA 483\n");
+    auto answer = request(server, 7, path);
+    EXPECT_NE(answer.find(R"("part1":"6440","part2":"5905")"), std::string::npos) << answer;
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,45 @@
+#include "aoc/alloc.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(AocAlloc, CountsPerPhase) {
+    // calls to operator new directly, since new-expressions may be elided by the compiler
+    auto mark = aoc::alloc_begin();
+    void* a = ::operator new(1000);
+    void* b = ::operator new(24);
+    ::operator delete(a);
+    auto stats = aoc::alloc_end(mark);
+    ::operator delete(b);
+
+    if (!aoc::alloc_tracking_enabled()) {
+        EXPECT_EQ(stats.count, 0);
+        EXPECT_EQ(stats.bytes, 0);
+        EXPECT_EQ(stats.peak, 0);
+        return;
+    }
+
+    EXPECT_EQ(stats.count, 2);
+    EXPECT_EQ(stats.bytes, 1024);
+    EXPECT_EQ(stats.peak, 1024);
+}
+
+TEST(AocAlloc, NestedPeaks) {
+    auto outer = aoc::alloc_begin();
+    void* held = ::operator new(100);
+
+    auto inner = aoc::alloc_begin();
+    ::operator delete(::operator new(5000));
+    auto inner_stats = aoc::alloc_end(inner);
+    auto outer_stats = aoc::alloc_end(outer);
+    ::operator delete(held);
+
+    if (!aoc::alloc_tracking_enabled()) {
+        GTEST_SKIP() << "allocation tracking is not compiled in";
+    }
+
+    // the inner peak is relative to its own start, the outer one includes it
+    EXPECT_EQ(inner_stats.count, 1);
+    EXPECT_EQ(inner_stats.peak, 5000);
+    EXPECT_EQ(outer_stats.count, 2);
+    EXPECT_EQ(outer_stats.peak, 5100);
+}
@@ -0,0 +1,96 @@
+#include "aoc/arena.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+TEST(AocArena, BumpsWithinBlock) {
+    aoc::Arena arena{{.block_size = 1024}};
+    auto* a = static_cast<std::byte*>(arena.allocate(16, 8));
+    auto* b = static_cast<std::byte*>(arena.allocate(16, 8));
+
+    EXPECT_EQ(b, a + 16);
+    EXPECT_EQ(arena.used(), 32);
+    EXPECT_EQ(arena.blocks(), 1);
+    EXPECT_EQ(arena.reserved(), 1024);
+}
+
+TEST(AocArena, Alignment) {
+    aoc::Arena arena{{.block_size = 1024}};
+    (void)arena.allocate(1, 1);
+    for (std::size_t align : {2, 4, 8, 16, 64, 256}) {
+        auto addr = reinterpret_cast<std::uintptr_t>(arena.allocate(3, align));
+        EXPECT_EQ(addr % align, 0) << "alignment " << align;
+    }
+}
+
+TEST(AocArena, Grows) {
+    aoc::Arena arena{{.block_size = 128}};
+    for (int i = 0; i < 10; ++i) {
+        (void)arena.allocate(96, 8);
+    }
+    EXPECT_EQ(arena.used(), 960);
+    EXPECT_GT(arena.blocks(), 1);
+    EXPECT_GE(arena.reserved(), 960);
+
+    // larger than any block so far
+    auto* big = arena.allocate(1 << 20, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(big) % 64, 0);
+    EXPECT_GE(arena.reserved(), 1 << 20);
+}
+
+TEST(AocArena, Reset) {
+    aoc::Arena arena{{.block_size = 128}};
+    for (int i = 0; i < 100; ++i) {
+        (void)arena.allocate(64, 8);
+    }
+    auto reserved = arena.reserved();
+    EXPECT_GT(arena.blocks(), 1);
+    arena.reset();
+
+    EXPECT_EQ(arena.used(), 0);
+    EXPECT_EQ(arena.blocks(), 1);
+    EXPECT_EQ(arena.reserved(), reserved);
+
+    // the same run again fits in the merged block
+    for (int i = 0; i < 100; ++i) {
+        (void)arena.allocate(64, 8);
+    }
+    EXPECT_EQ(arena.blocks(), 1);
+    EXPECT_EQ(arena.used(), 6400);
+}
+
+TEST(AocArena, PmrContainers) {
+    aoc::Arena arena{};
+    std::pmr::unordered_map<std::pmr::string, std::pmr::vector<int>> map{&arena};
+    for (int i = 0; i < 100; ++i) {
+        auto key = "a long enough key to skip the SSO " + std::to_string(i);
+        map[std::pmr::string{key}].assign({i, i + 1, i + 2});
+    }
+
+    EXPECT_EQ(map.size(), 100);
+    EXPECT_EQ(map.at("a long enough key to skip the SSO 42")[1], 43);
+    EXPECT_EQ(map.get_allocator().resource(), &arena);
+    EXPECT_EQ(map.begin()->first.get_allocator().resource(), &arena);
+    EXPECT_EQ(map.begin()->second.get_allocator().resource(), &arena);
+    EXPECT_GT(arena.used(), 0);
+}
+
+TEST(AocArena, HugePages) {
+    aoc::Arena arena{{.block_size = 4096, .huge_pages = true}};
+    auto* p = static_cast<char*>(arena.allocate(100, 8));
+    p[99] = 'x';
+    EXPECT_EQ(p[99], 'x');
+
+#if defined(__linux__)
+    // rounded up to a whole huge page
+    EXPECT_TRUE(arena.huge_pages());
+    EXPECT_EQ(arena.reserved() % (2 << 20), 0);
+#else
+    EXPECT_FALSE(arena.huge_pages());
+#endif
+}
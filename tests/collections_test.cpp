@@ -3,6 +3,11 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <cstdint>
+#include <forward_list>
+#include <list>
+#include <string>
+#include <vector>
 
 TEST(AocCollections, ZipCopy) {
     std::vector<int> a{1, 2, 3, 4};
@@ -23,3 +28,220 @@ TEST(AocCollections, ZipCopy) {
         EXPECT_EQ(second, exp_second) << "Mismatch on second at i=" << i;
     }
 }
+
+TEST(AocCollections, Zip) {
+    std::vector<int> a{1, 2, 3, 4};
+    std::array<std::string, 3> b{"foo", "bar", "baz"};
+
+    auto zipped = aoc::zip(a, b);
+    static_assert(std::ranges::random_access_range<decltype(zipped)>);
+    static_assert(std::ranges::sized_range<decltype(zipped)>);
+    EXPECT_EQ(zipped.size(), 3);
+    EXPECT_EQ(zipped[2].first, 3);
+    EXPECT_EQ(zipped[2].second, "baz");
+
+    size_t count{};
+    for (auto [first, second] : zipped) {
+        EXPECT_EQ(first, a.at(count)) << "Mismatch on first at i=" << count;
+        EXPECT_EQ(second, b.at(count)) << "Mismatch on second at i=" << count;
+        ++count;
+    }
+    EXPECT_EQ(count, 3);
+}
+
+TEST(AocCollections, ZipMutate) {
+    std::vector<int> a{1, 2, 3};
+    std::vector<int> b{10, 20, 30, 40};
+
+    for (auto [x, y] : aoc::zip(a, b)) {
+        x += y;
+    }
+
+    EXPECT_EQ(a, (std::vector<int>{11, 22, 33}));
+}
+
+TEST(AocCollections, ZipForward) {
+    std::list<int> a{1, 2, 3};
+    std::forward_list<char> b{'a', 'b'};
+
+    auto zipped = aoc::zip(a, b);
+    static_assert(std::ranges::forward_range<decltype(zipped)>);
+    static_assert(!std::ranges::bidirectional_range<decltype(zipped)>);
+
+    std::vector<std::pair<int, char>> result{};
+    for (auto pair : zipped) {
+        result.emplace_back(pair);
+    }
+    std::vector<std::pair<int, char>> expected{{1, 'a'}, {2, 'b'}};
+    EXPECT_EQ(result, expected);
+}
+
+TEST(AocCollections, Enumerate) {
+    const std::vector<std::string> values{"foo", "bar", "baz"};
+
+    size_t count{};
+    for (const auto [i, value] : aoc::enumerate(values)) {
+        EXPECT_EQ(i, count);
+        EXPECT_EQ(value, values.at(i));
+        ++count;
+    }
+    EXPECT_EQ(count, values.size());
+}
+
+TEST(AocCollections, Chunk) {
+    const std::vector<int> values{1, 2, 3, 4, 5, 6, 7};
+    const std::vector<std::vector<int>> expected{{1, 2, 3}, {4, 5, 6}, {7}};
+
+    auto chunks = aoc::chunk(values, 3);
+    EXPECT_EQ(chunks.size(), expected.size());
+
+    size_t i{};
+    for (auto c : chunks) {
+        ASSERT_LT(i, expected.size());
+        EXPECT_EQ(std::vector<int>(c.begin(), c.end()), expected.at(i)) << "at chunk " << i;
+        ++i;
+    }
+    EXPECT_EQ(i, expected.size());
+}
+
+TEST(AocCollections, SoA) {
+    enum Field {
+        Label,
+        Value,
+    };
+
+    aoc::SoA<std::string, int> soa{{"foo", 1}, {"bar", 2}};
+    soa.emplace_back("baz", 3);
+    soa.push_back({"qux", 4});
+
+    ASSERT_EQ(soa.size(), 4);
+    EXPECT_EQ(soa.column<Label>()[2], "baz");
+    EXPECT_EQ(soa.column<Value>()[3], 4);
+
+    auto [label, value] = soa[1];
+    EXPECT_EQ(label, "bar");
+    EXPECT_EQ(value, 2);
+
+    // rows are references into each column
+    value = 20;
+    EXPECT_EQ(soa.column<Value>()[1], 20);
+
+    int sum{};
+    for (auto [l, v] : soa.rows()) {
+        EXPECT_FALSE(l.empty());
+        sum += v;
+    }
+    EXPECT_EQ(sum, 1 + 20 + 3 + 4);
+}
+
+TEST(AocCollections, SoAAlignment) {
+    aoc::SoA<char, double, uint64_t> soa{};
+    for (int i = 0; i < 100; ++i) {
+        soa.emplace_back('x', 1.0, 2);
+    }
+
+    auto is_aligned = [](const void* p) {
+        return reinterpret_cast<std::uintptr_t>(p) % decltype(soa)::alignment == 0;
+    };
+    EXPECT_TRUE(is_aligned(soa.column<0>().data()));
+    EXPECT_TRUE(is_aligned(soa.column<1>().data()));
+    EXPECT_TRUE(is_aligned(soa.column<2>().data()));
+}
+
+TEST(AocCollections, SmallVector) {
+    aoc::SmallVector<std::string, 2> v{"foo"};
+    EXPECT_TRUE(v.is_inline());
+    v.emplace_back("bar");
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(v.capacity(), 2);
+
+    // growing past the inline capacity moves everything to the heap
+    v.push_back("baz");
+    EXPECT_FALSE(v.is_inline());
+    ASSERT_EQ(v.size(), 3);
+    EXPECT_EQ(v.front(), "foo");
+    EXPECT_EQ(v.at(1), "bar");
+    EXPECT_EQ(v.back(), "baz");
+
+    v.pop_back();
+    EXPECT_EQ(v.size(), 2);
+    EXPECT_EQ(
+        std::vector<std::string>(v.begin(), v.end()), (std::vector<std::string>{"foo", "bar"})
+    );
+}
+
+TEST(AocCollections, SmallVectorCopyMove) {
+    aoc::SmallVector<std::string, 2> small{"a"};
+    aoc::SmallVector<std::string, 2> large{"a", "b", "c"};
+
+    auto small_copy = small;
+    auto large_copy = large;
+    EXPECT_EQ(small_copy, small);
+    EXPECT_EQ(large_copy, large);
+    EXPECT_TRUE(small_copy.is_inline());
+    EXPECT_FALSE(large_copy.is_inline());
+
+    auto small_moved = std::move(small_copy);
+    auto large_moved = std::move(large_copy);
+    EXPECT_EQ(small_moved, small);
+    EXPECT_EQ(large_moved, large);
+    EXPECT_TRUE(large_copy.empty());  // NOLINT(*-use-after-move)
+
+    small_moved = large_moved;
+    EXPECT_EQ(small_moved, large);
+    large_moved = small;
+    EXPECT_EQ(large_moved, small);
+    EXPECT_LT(small, large);
+}
+
+TEST(AocCollections, SmallVectorPushSelf) {
+    // long enough to live on the heap, so a copy from freed storage would show
+    const std::string first(64, 'a');
+    const std::string second(64, 'b');
+    aoc::SmallVector<std::string, 2> v{first, second};
+
+    // full inline buffer, then full heap buffer
+    v.push_back(v[0]);
+    EXPECT_FALSE(v.is_inline());
+    v.push_back(v[1]);
+    ASSERT_EQ(v.size(), v.capacity());
+    v.emplace_back(v.back());
+    EXPECT_EQ(
+        std::vector<std::string>(v.begin(), v.end()),
+        (std::vector<std::string>{first, second, first, second, second})
+    );
+}
+
+TEST(AocCollections, FlatSet) {
+    aoc::FlatSet<int> set{5, 1, 3, 3, 9};
+    EXPECT_EQ(std::vector<int>(set.begin(), set.end()), (std::vector<int>{1, 3, 5, 9}));
+
+    EXPECT_TRUE(set.insert(4));
+    EXPECT_FALSE(set.insert(4));
+    EXPECT_TRUE(set.contains(4));
+    EXPECT_FALSE(set.contains(2));
+    EXPECT_TRUE(aoc::contains(set, 9));
+
+    EXPECT_TRUE(set.erase(1));
+    EXPECT_FALSE(set.erase(1));
+    EXPECT_EQ(set.size(), 4);
+    EXPECT_EQ(set.find(7), set.end());
+    EXPECT_EQ(*set.find(5), 5);
+}
+
+TEST(AocCollections, FlatSetBounds) {
+    aoc::FlatSet<int> empty{};
+    EXPECT_EQ(empty.lower_bound(1), empty.end());
+    EXPECT_EQ(empty.upper_bound(1), empty.end());
+
+    aoc::FlatSet<int> set{2, 4, 6, 8};
+    for (int i = 0; i < 10; ++i) {
+        auto lo = std::lower_bound(set.begin(), set.end(), i);
+        auto hi = std::upper_bound(set.begin(), set.end(), i);
+        EXPECT_EQ(set.lower_bound(i), lo) << "with i=" << i;
+        EXPECT_EQ(set.upper_bound(i), hi) << "with i=" << i;
+    }
+
+    // number of values strictly between 3 and 8
+    EXPECT_EQ(set.lower_bound(8) - set.upper_bound(3), 2);
+}
@@ -0,0 +1,157 @@
+#include "aoc/core.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+TEST(AocCore, AssertFIsLazy) {
+    int calls{};
+    auto arg = [&calls]() {
+        ++calls;
+        return 42;
+    };
+
+    AOC_ASSERTF(calls == 0, "calls was {}", arg());
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(AocCoreDeathTest, AssertF) {
+    EXPECT_DEATH(AOC_ASSERTF(1 + 1 == 3, "value was {}", 2), "");
+}
+
+TEST(AocCore, PanicsThrow) {
+    aoc::set_panics_throw(true);
+    try {
+        AOC_ASSERTF(1 + 1 == 3, "value was {}", 2);
+        ADD_FAILURE() << "the assertion did not panic";
+    } catch (const aoc::PanicError& e) {
+        EXPECT_STREQ(e.what(), "value was 2");
+    }
+    aoc::set_panics_throw(false);
+}
+
+TEST(AocCore, DebugAssert) {
+    int calls{};
+    auto check = [&calls]() {
+        ++calls;
+        return true;
+    };
+
+    AOC_DEBUG_ASSERT(check(), "check failed");
+    AOC_DEBUG_ASSERTF(check(), "check failed with calls={}", calls);
+
+    // compiled out builds must not evaluate the expression at all
+    EXPECT_EQ(calls, AOC_ENABLE_DEBUG_ASSERTS ? 2 : 0);
+}
+
+TEST(AocCore, ScopedTimer) {
+    auto& registry = aoc::PhaseRegistry::instance();
+    registry.clear();
+
+    {
+        aoc::ScopedTimer timer{"outer"};
+        for (int i = 0; i < 3; ++i) {
+            aoc::ScopedTimer inner{"inner"};
+        }
+    }
+    auto result = aoc::timed("inner", []() { return 42; });
+    EXPECT_EQ(result, 42);
+
+    auto stats = registry.stats();
+    ASSERT_EQ(stats.size(), 2);
+    EXPECT_EQ(stats[0].name, "outer");
+    EXPECT_EQ(stats[0].calls, 1);
+    EXPECT_EQ(stats[1].name, "inner");
+    EXPECT_EQ(stats[1].calls, 4);
+    EXPECT_LE(stats[1].min, stats[1].max);
+    EXPECT_GE(stats[0].total, stats[0].max);
+
+    auto inner = registry.find("inner");
+    ASSERT_TRUE(inner.has_value());
+    EXPECT_EQ(inner->calls, 4);
+    EXPECT_FALSE(registry.find("missing").has_value());
+
+    registry.clear();
+}
+
+TEST(AocCore, PhaseInputBytes) {
+    auto& registry = aoc::PhaseRegistry::instance();
+    registry.clear();
+
+    // input sizes are summed over the calls that have counters, like the counters themselves
+    auto id = registry.id("day1/part1");
+    registry.record(id, {.counters = aoc::PerfSample{10, 20, 1, 1}, .input_bytes = 100});
+    registry.record(id, {.counters = aoc::PerfSample{10, 20, 1, 1}, .input_bytes = 100});
+    registry.record(id, {.input_bytes = 100});
+    registry.record(registry.id("day2/part1"), {.counters = aoc::PerfSample{}, .input_bytes = 7});
+
+    auto stats = registry.stats();
+    ASSERT_EQ(stats.size(), 2);
+    EXPECT_EQ(stats[0].counted_calls, 2);
+    EXPECT_EQ(stats[0].input_bytes, 200);
+    EXPECT_EQ(stats[1].input_bytes, 7);
+
+    registry.clear();
+}
+
+TEST(AocCore, TraceEvents) {
+    auto& registry = aoc::PhaseRegistry::instance();
+    registry.clear();
+    registry.set_tracing(true);
+
+    auto main_thread = aoc::thread_index();
+    registry.set_thread_name("main");
+    {
+        aoc::ScopedTimer timer{"traced"};
+        std::thread worker{[]() {
+            aoc::ScopedTimer inner{"worker"};
+        }};
+        worker.join();
+    }
+
+    std::ostringstream os{};
+    registry.write_trace(os);
+    auto trace = os.str();
+
+    EXPECT_NE(trace.find(R"("name":"traced","cat":"phase","ph":"X")"), std::string::npos);
+    EXPECT_NE(trace.find(R"("name":"worker","cat":"phase","ph":"X")"), std::string::npos);
+    EXPECT_NE(
+        trace.find(fmt::format(R"("tid":{},"args":{{"name":"main"}})", main_thread)),
+        std::string::npos
+    );
+    EXPECT_NE(trace.find(fmt::format(R"("tid":{},"ts")", main_thread)), std::string::npos);
+
+    registry.set_tracing(false);
+    registry.clear();
+}
+
+TEST(AocCore, TraceKeepsLatestEvents) {
+    auto& registry = aoc::PhaseRegistry::instance();
+    registry.clear();
+    registry.set_tracing(true);
+    auto capacity = registry.trace_capacity();
+    registry.set_trace_capacity(2);
+
+    for (auto name : {"first", "second", "third"}) {
+        aoc::ScopedTimer timer{name};
+    }
+
+    std::ostringstream os{};
+    registry.write_trace(os);
+    auto trace = os.str();
+
+    EXPECT_EQ(trace.find(R"("name":"first")"), std::string::npos);
+    auto second = trace.find(R"("name":"second")");
+    auto third = trace.find(R"("name":"third")");
+    ASSERT_NE(second, std::string::npos);
+    ASSERT_NE(third, std::string::npos);
+    EXPECT_LT(second, third);
+    EXPECT_NE(trace.find(R"("otherData":{"dropped_events":1})"), std::string::npos);
+    EXPECT_EQ(registry.stats().size(), 3);
+
+    registry.set_trace_capacity(capacity);
+    registry.set_tracing(false);
+    registry.clear();
+}
@@ -0,0 +1,112 @@
+#include "aoc/fs.hpp"
+#include "aoc/generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+aoc::Generator<int> count(int n, std::vector<int>* log = nullptr) {
+    for (int i = 0; i < n; ++i) {
+        if (log != nullptr) {
+            log->push_back(i);
+        }
+        co_yield i;
+    }
+}
+
+aoc::Generator<std::unique_ptr<int>> boxes(int n) {
+    for (int i = 0; i < n; ++i) {
+        co_yield std::make_unique<int>(i);
+    }
+}
+
+aoc::Generator<int> failing() {
+    co_yield 1;
+    throw std::runtime_error{"bad record"};
+}
+
+}  // namespace
+
+static_assert(std::ranges::input_range<aoc::Generator<int>>);
+static_assert(std::ranges::view<aoc::Generator<int>>);
+
+TEST(AocGenerator, Yields) {
+    std::vector<int> values{};
+    for (auto x : count(5)) {
+        values.push_back(x);
+    }
+    EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 3, 4}));
+
+    EXPECT_TRUE(aoc::collect(count(0)).empty());
+}
+
+TEST(AocGenerator, IsLazy) {
+    std::vector<int> log{};
+    auto gen = count(100, &log);
+    EXPECT_TRUE(log.empty());
+
+    // the body only runs as far as the consumer pulls
+    auto it = gen.begin();
+    EXPECT_EQ(log, (std::vector<int>{0}));
+    ++it;
+    ++it;
+    EXPECT_EQ(*it, 2);
+    EXPECT_EQ(log, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(AocGenerator, Views) {
+    auto evens = count(10) | std::views::filter([](int x) { return x % 2 == 0; })
+        | std::views::transform([](int x) { return x * 10; });
+
+    std::vector<int> values{};
+    for (auto x : evens) {
+        values.push_back(x);
+    }
+    EXPECT_EQ(values, (std::vector<int>{0, 20, 40, 60, 80}));
+}
+
+TEST(AocGenerator, MovesValuesOut) {
+    auto values = aoc::collect(boxes(3));
+    ASSERT_EQ(values.size(), 3);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(*values[static_cast<size_t>(i)], i);
+    }
+}
+
+TEST(AocGenerator, Move) {
+    auto a = count(3);
+    auto b = std::move(a);
+    EXPECT_EQ(aoc::collect(std::move(b)), (std::vector<int>{0, 1, 2}));
+}
+
+TEST(AocGenerator, Exceptions) {
+    auto gen = failing();
+    auto it = gen.begin();
+    EXPECT_EQ(*it, 1);
+    EXPECT_THROW(++it, std::runtime_error);
+    EXPECT_TRUE(it == std::default_sentinel);
+}
+
+TEST(AocGenerator, ReadLines) {
+    auto path = std::filesystem::temp_directory_path() / "aoc_read_lines_test.txt";
+    {
+        std::ofstream out{path};
+        out << "first\n\nthird line\n";
+    }
+
+    EXPECT_EQ(
+        aoc::collect(aoc::read_lines(path)), (std::vector<std::string>{"first", "", "third line"})
+    );
+    std::filesystem::remove(path);
+
+    EXPECT_THROW(aoc::collect(aoc::read_lines(path)), std::runtime_error);
+}
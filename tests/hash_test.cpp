@@ -70,3 +70,20 @@ TEST(AocHash, HashStructStdAdl) {
     EXPECT_TRUE(nodes.contains(node));
     EXPECT_TRUE(nodes.contains(TEST_NODE));
 }
+
+TEST(AocHash, Xxh64) {
+    // reference values from the xxHash implementation
+    EXPECT_EQ(aoc::xxh64(""), 0xEF46DB3751D8E999);
+    EXPECT_EQ(aoc::xxh64("a"), 0xD24EC4F1A98C6E5B);
+    EXPECT_EQ(aoc::xxh64("abc"), 0x44BC2CF5AD770999);
+    EXPECT_EQ(aoc::xxh64("abc", 42), 0x13C1D910702770E6);
+    EXPECT_EQ(aoc::xxh64("Nobody inspects the spammish repetition"), 0xFBCEA83C8A378BF1);
+
+    std::string bytes{};
+    for (int r = 0; r < 3; ++r) {
+        for (int b = 0; b < 256; ++b) {
+            bytes += static_cast<char>(b);
+        }
+    }
+    EXPECT_EQ(aoc::xxh64(bytes), 0x8E03C838C596036F);
+}
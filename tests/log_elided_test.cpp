@@ -0,0 +1,42 @@
+// built with a raised compile-time level, whatever the rest of the tree uses, so the debug
+// and trace macros below are removed rather than filtered at runtime
+#undef AOC_LOG_LEVEL
+#define AOC_LOG_LEVEL 2  // AOC_LOG_LEVEL_INFO
+
+#include "aoc/log.hpp"
+
+#include <gtest/gtest.h>
+#include <spdlog/sinks/ostream_sink.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+static_assert(AOC_LOG_LEVEL == AOC_LOG_LEVEL_INFO);
+
+TEST(AocLog, ElidesCallsBelowCompiledLevel) {
+    int calls{};
+    auto arg = [&calls]() {
+        ++calls;
+        return calls;
+    };
+
+    std::ostringstream os{};
+    auto previous = spdlog::default_logger();
+    auto logger = std::make_shared<spdlog::logger>(
+        "elided",
+        std::make_shared<spdlog::sinks::ostream_sink_st>(os)
+    );
+    logger->set_pattern("%l %v");
+    logger->set_level(spdlog::level::trace);
+    spdlog::set_default_logger(logger);
+
+    // the runtime level allows everything, only the compile-time level removes these
+    AOC_TRACE("trace {}", arg());
+    AOC_DEBUG("debug {}", arg());
+    AOC_INFO("info {}", arg());
+    spdlog::set_default_logger(previous);
+
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(os.str(), "info info 1\n");
+}
@@ -0,0 +1,20 @@
+#include "aoc/log.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(AocLog, SkipsArgumentsBelowLevel) {
+    int calls{};
+    auto arg = [&calls]() {
+        ++calls;
+        return calls;
+    };
+
+    auto level = spdlog::get_level();
+    spdlog::set_level(spdlog::level::off);
+    AOC_TRACE("{}", arg());
+    AOC_DEBUG("{}", arg());
+    AOC_INFO("{}", arg());
+    spdlog::set_level(level);
+
+    EXPECT_EQ(calls, 0);
+}
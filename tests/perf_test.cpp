@@ -0,0 +1,63 @@
+#include "aoc/perf.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(AocPerf, SampleArithmetic) {
+    aoc::PerfSample a{100, 250, 3, 4};
+    aoc::PerfSample b{40, 50, 1, 1};
+
+    auto diff = a - b;
+    EXPECT_EQ(diff.cycles, 60);
+    EXPECT_EQ(diff.instructions, 200);
+    EXPECT_EQ(diff.cache_misses, 2);
+    EXPECT_EQ(diff.branch_misses, 3);
+    EXPECT_DOUBLE_EQ(a.ipc(), 2.5);
+    EXPECT_DOUBLE_EQ(aoc::PerfSample{}.ipc(), 0.0);
+
+    diff += b;
+    EXPECT_EQ(diff.cycles, a.cycles);
+    EXPECT_EQ(diff.branch_misses, a.branch_misses);
+
+    // multiplexed reads are estimates, a lower later read must not wrap around
+    auto clamped = b - a;
+    EXPECT_EQ(clamped.cycles, 0);
+    EXPECT_EQ(clamped.instructions, 0);
+    EXPECT_EQ(clamped.cache_misses, 0);
+    EXPECT_EQ(clamped.branch_misses, 0);
+}
+
+TEST(AocPerf, CountersDegradeGracefully) {
+    aoc::PerfCounters counters{};
+
+    volatile aoc::u64 sink{};
+    for (aoc::u64 i = 0; i < 10000; ++i) {
+        sink = sink + i;
+    }
+
+    auto sample = counters.read();
+    if (counters.available()) {
+        EXPECT_GT(sample.cycles, 0);
+        EXPECT_GT(sample.instructions, 0);
+    } else {
+        EXPECT_EQ(sample.cycles, 0);
+        EXPECT_EQ(sample.instructions, 0);
+    }
+}
+
+TEST(AocPerf, AttributedCounters) {
+    aoc::PerfCounters counters{};
+    counters.add_delegated({100, 200, 10, 20});
+    counters.add_lent({40, 50, 5, 5});
+
+    // work done for this thread elsewhere is added, work it did for others taken out
+    auto sample = counters.read_attributed();
+    if (counters.available()) {
+        EXPECT_GE(sample.cycles, 60);
+        EXPECT_GE(sample.instructions, 150);
+    } else {
+        EXPECT_EQ(sample.cycles, 60);
+        EXPECT_EQ(sample.instructions, 150);
+        EXPECT_EQ(sample.cache_misses, 5);
+        EXPECT_EQ(sample.branch_misses, 15);
+    }
+}
@@ -0,0 +1,95 @@
+#include "aoc/pipeline.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// numbers 1..count, one per line, in a file named after the running test
+std::filesystem::path write_numbers(int count) {
+    const auto* test = testing::UnitTest::GetInstance()->current_test_info();
+    auto path = std::filesystem::temp_directory_path()
+        / (std::string{"aoc_pipeline_"} + test->name() + ".txt");
+    std::ofstream out{path};
+    for (int i = 1; i <= count; ++i) {
+        out << i << '\n';
+    }
+    return path;
+}
+
+}  // namespace
+
+TEST(AocPipeline, ReducesEveryLine) {
+    auto path = write_numbers(10'000);
+
+    for (aoc::usize parsers : {1, 2, 5}) {
+        for (aoc::usize batch : {1, 7, 256, 20'000}) {
+            std::vector<int> seen{};
+            aoc::run_pipeline(
+                path,
+                [](const std::string& line) { return std::stoi(line); },
+                [&seen](std::vector<int>& records) {
+                    // records of a batch keep their input order
+                    EXPECT_TRUE(std::ranges::is_sorted(records));
+                    seen.insert(seen.end(), records.begin(), records.end());
+                },
+                {.parsers = parsers, .batch_lines = batch, .queue_batches = 2}
+            );
+
+            std::ranges::sort(seen);
+            ASSERT_EQ(seen.size(), 10'000) << parsers << " parsers, batches of " << batch;
+            EXPECT_EQ(seen.front(), 1);
+            EXPECT_EQ(seen.back(), 10'000);
+            EXPECT_TRUE(std::ranges::adjacent_find(seen) == seen.end());
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(AocPipeline, EmptyFile) {
+    auto path = write_numbers(0);
+
+    int batches{};
+    aoc::run_pipeline(
+        path,
+        [](const std::string& line) { return line; },
+        [&batches](std::vector<std::string>&) { batches++; }
+    );
+    EXPECT_EQ(batches, 0);
+    std::filesystem::remove(path);
+}
+
+TEST(AocPipeline, Exceptions) {
+    auto path = write_numbers(5'000);
+
+    // a failing parser stops the whole pipeline
+    auto parse = [](const std::string& line) {
+        if (line == "4321") {
+            throw std::invalid_argument{"bad line"};
+        }
+        return 0;
+    };
+    auto ignore = [](std::vector<int>&) {};
+    EXPECT_THROW(
+        aoc::run_pipeline(path, parse, ignore, {.parsers = 3, .batch_lines = 16}),
+        std::invalid_argument
+    );
+
+    // and so does a failing reducer
+    auto reduce = [](std::vector<int>&) { throw std::runtime_error{"bad batch"}; };
+    EXPECT_THROW(
+        aoc::run_pipeline(path, [](const std::string&) { return 0; }, reduce, {.batch_lines = 16}),
+        std::runtime_error
+    );
+    std::filesystem::remove(path);
+
+    EXPECT_THROW(
+        aoc::run_pipeline(path, [](const std::string&) { return 0; }, ignore), std::runtime_error
+    );
+}
@@ -0,0 +1,108 @@
+#include "aoc/ring_buffer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(AocRingBuffer, SpscFifo) {
+    aoc::SpscRing<int> ring{3};
+    EXPECT_EQ(ring.capacity(), 4);
+    EXPECT_FALSE(ring.try_pop().has_value());
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push(int{i}));
+    }
+    EXPECT_FALSE(ring.try_push(4));
+
+    EXPECT_EQ(ring.try_pop(), 0);
+    EXPECT_TRUE(ring.try_push(4));
+    for (int i = 1; i < 5; ++i) {
+        EXPECT_EQ(ring.try_pop(), i);
+    }
+    EXPECT_FALSE(ring.try_pop().has_value());
+}
+
+TEST(AocRingBuffer, FullPushKeepsValue) {
+    aoc::SpscRing<std::unique_ptr<int>> spsc{1};
+    aoc::MpscRing<std::unique_ptr<int>> mpsc{1};
+    EXPECT_EQ(spsc.capacity(), 1);
+    EXPECT_EQ(mpsc.capacity(), 2);
+    while (spsc.try_push(std::make_unique<int>(1))) {}
+    while (mpsc.try_push(std::make_unique<int>(1))) {}
+
+    auto value = std::make_unique<int>(2);
+    EXPECT_FALSE(spsc.try_push(std::move(value)));
+    EXPECT_FALSE(mpsc.try_push(std::move(value)));
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 2);
+}
+
+TEST(AocRingBuffer, MpscFifo) {
+    aoc::MpscRing<int> ring{4};
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_TRUE(ring.try_push(lap * 10 + i));
+        }
+        EXPECT_FALSE(ring.try_push(-1));
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_EQ(ring.try_pop(), lap * 10 + i);
+        }
+        EXPECT_FALSE(ring.try_pop().has_value());
+    }
+}
+
+TEST(AocRingBuffer, SpscThreads) {
+    constexpr int COUNT{100'000};
+    aoc::SpscRing<int> ring{64};
+
+    std::jthread producer{[&ring] {
+        for (int i = 0; i < COUNT; ++i) {
+            while (!ring.try_push(int{i})) {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    // values arrive complete and in order
+    for (int expected = 0; expected < COUNT;) {
+        if (auto value = ring.try_pop()) {
+            ASSERT_EQ(*value, expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+TEST(AocRingBuffer, MpscThreads) {
+    constexpr int PRODUCERS{4};
+    constexpr int COUNT{25'000};
+    aoc::MpscRing<int> ring{64};
+
+    std::vector<std::jthread> producers{};
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (int i = 0; i < COUNT; ++i) {
+                while (!ring.try_push(p * COUNT + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // every value arrives once, and each producer's values keep their order
+    std::vector<int> last(PRODUCERS, -1);
+    for (int received = 0; received < PRODUCERS * COUNT;) {
+        if (auto value = ring.try_pop()) {
+            auto p = *value / COUNT;
+            ASSERT_GT(*value % COUNT, last[static_cast<size_t>(p)]);
+            last[static_cast<size_t>(p)] = *value % COUNT;
+            received++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    EXPECT_EQ(last, std::vector<int>(PRODUCERS, COUNT - 1));
+}
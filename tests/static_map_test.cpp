@@ -0,0 +1,49 @@
+#include "aoc/static_map.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using Colors = aoc::static_map<"red", "green", "blue">;
+
+static_assert(Colors::size() == 3);
+static_assert(Colors::index("red") == 0);
+static_assert(Colors::index("green") == 1);
+static_assert(Colors::index("blue") == 2);
+static_assert(!Colors::contains("yellow"));
+
+TEST(AocStaticMap, Find) {
+    EXPECT_EQ(Colors::find("red"), 0);
+    EXPECT_EQ(Colors::find("green"), 1);
+    EXPECT_EQ(Colors::find("blue"), 2);
+
+    // runtime strings must resolve the same as literals
+    std::string key{"gre"};
+    key += "en";
+    EXPECT_EQ(Colors::find(key), 1);
+}
+
+TEST(AocStaticMap, FindMissing) {
+    const std::vector<std::string> missing{"", "r", "reds", "Red", "blue ", "purple"};
+
+    for (const auto& key : missing) {
+        EXPECT_FALSE(Colors::find(key).has_value()) << "with key `" << key << '`';
+        EXPECT_FALSE(Colors::contains(key)) << "with key `" << key << '`';
+    }
+}
+
+TEST(AocStaticMap, Keys) {
+    using Maps = aoc::static_map<
+        "seed-to-soil",
+        "soil-to-fertilizer",
+        "fertilizer-to-water",
+        "water-to-light",
+        "light-to-temperature",
+        "temperature-to-humidity",
+        "humidity-to-location">;
+
+    ASSERT_EQ(Maps::keys.size(), Maps::size());
+    for (size_t i = 0; i < Maps::size(); ++i) {
+        EXPECT_EQ(Maps::index(Maps::keys.at(i)), i) << "with key `" << Maps::keys.at(i) << '`';
+    }
+}
@@ -0,0 +1,78 @@
+#include "aoc/stats.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+TEST(AocStats, Percentile) {
+    std::vector<aoc::f64> sorted{10, 20, 30, 40, 50};
+
+    EXPECT_DOUBLE_EQ(aoc::percentile(sorted, 0.0), 10);
+    EXPECT_DOUBLE_EQ(aoc::percentile(sorted, 0.5), 30);
+    EXPECT_DOUBLE_EQ(aoc::percentile(sorted, 1.0), 50);
+    EXPECT_DOUBLE_EQ(aoc::percentile(sorted, 0.9), 46);
+    EXPECT_DOUBLE_EQ(aoc::percentile(sorted, 0.125), 15);
+    EXPECT_DOUBLE_EQ(aoc::percentile(std::vector<aoc::f64>{7}, 0.99), 7);
+}
+
+TEST(AocStats, Describe) {
+    // unsorted on purpose, with one stall far outside the fences
+    std::vector<aoc::f64> samples{12, 10, 11, 13, 10, 12, 11, 1000, 11, 10};
+    auto d = aoc::describe(samples);
+
+    EXPECT_EQ(d.samples, 10);
+    EXPECT_EQ(d.outliers, 1);
+    EXPECT_DOUBLE_EQ(d.min, 10);
+    EXPECT_DOUBLE_EQ(d.median, 11);
+    EXPECT_DOUBLE_EQ(d.max, 1000);
+    EXPECT_GT(d.p99, d.p90);
+
+    // the stall is kept in the percentiles but not in the mean
+    EXPECT_DOUBLE_EQ(d.mean, 100.0 / 9.0);
+    EXPECT_NEAR(d.stddev, 1.054, 1e-3);
+}
+
+TEST(AocStats, DescribeEdgeCases) {
+    auto empty = aoc::describe({});
+    EXPECT_EQ(empty.samples, 0);
+    EXPECT_DOUBLE_EQ(empty.mean, 0);
+
+    std::vector<aoc::f64> one{5};
+    auto single = aoc::describe(one);
+    EXPECT_EQ(single.outliers, 0);
+    EXPECT_DOUBLE_EQ(single.median, 5);
+    EXPECT_DOUBLE_EQ(single.mean, 5);
+    EXPECT_DOUBLE_EQ(single.stddev, 0);
+}
+
+TEST(AocStats, FormatNanos) {
+    EXPECT_EQ(aoc::format_nanos(850), "850ns");
+    EXPECT_EQ(aoc::format_nanos(12'500), "12.50us");
+    EXPECT_EQ(aoc::format_nanos(3'200'000), "3.20ms");
+    EXPECT_EQ(aoc::format_nanos(1'250'000'000), "1.250s");
+}
+
+TEST(AocStats, MannWhitney) {
+    std::vector<aoc::f64> low{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    std::vector<aoc::f64> high{11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+    std::vector<aoc::f64> mixed{2, 4, 6, 8, 10, 1, 3, 5, 7, 9};
+
+    // no overlap at all: U = 0, z = 49.5 / sqrt(175)
+    EXPECT_NEAR(aoc::mann_whitney(low, high), 1.8267e-4, 1e-7);
+    EXPECT_DOUBLE_EQ(aoc::mann_whitney(low, high), aoc::mann_whitney(high, low));
+    EXPECT_DOUBLE_EQ(aoc::mann_whitney(low, mixed), 1.0);
+
+    // a single stall does not move the ranks much
+    std::vector<aoc::f64> stalled{low};
+    stalled.back() = 1e9;
+    EXPECT_GT(aoc::mann_whitney(low, stalled), 0.5);
+}
+
+TEST(AocStats, MannWhitneyEdgeCases) {
+    std::vector<aoc::f64> same{5, 5, 5, 5};
+
+    EXPECT_DOUBLE_EQ(aoc::mann_whitney({}, same), 1.0);
+    EXPECT_DOUBLE_EQ(aoc::mann_whitney(same, {}), 1.0);
+    // every value tied, so there is no evidence of a shift
+    EXPECT_DOUBLE_EQ(aoc::mann_whitney(same, same), 1.0);
+}
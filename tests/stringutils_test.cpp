@@ -176,3 +176,27 @@ TEST(AocStringUtils, Trim) {
         EXPECT_EQ(trimmed, expected.both);
     }
 }
+
+// the splitting functions can run on embedded inputs at compile time
+constexpr aoc::usize count_fields(std::string_view s) {
+    return aoc::split(s, ' ', aoc::SplitOptions::DiscardEmpty | aoc::SplitOptions::Trim).size();
+}
+
+static_assert(count_fields("  7  15   30 ") == 3);
+static_assert(aoc::split_once("Time: 7", ':')->second == " 7");
+static_assert(aoc::trim(std::string_view{" \t x \n"}) == "x");
+
+TEST(AocStringUtils, ParseInt) {
+    static_assert(aoc::parse_int<int>("-42") == -42);
+
+    EXPECT_EQ(aoc::parse_int<int>("0"), 0);
+    EXPECT_EQ(aoc::parse_int<int>("1234"), 1234);
+    EXPECT_EQ(aoc::parse_int<aoc::i64>("-9223372036854775808"), INT64_MIN);
+    EXPECT_EQ(aoc::parse_int<aoc::u64>("18446744073709551615"), UINT64_MAX);
+
+    EXPECT_EQ(aoc::parse_int<int>(""), std::nullopt);
+    EXPECT_EQ(aoc::parse_int<int>("-"), std::nullopt);
+    EXPECT_EQ(aoc::parse_int<int>("12a"), std::nullopt);
+    EXPECT_EQ(aoc::parse_int<int>(" 12"), std::nullopt);
+    EXPECT_EQ(aoc::parse_int<unsigned>("-1"), std::nullopt);
+}
@@ -0,0 +1,113 @@
+#include "aoc/task_graph.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+TEST(AocTaskGraph, Empty) {
+    aoc::ThreadPool pool{2};
+    aoc::TaskGraph graph{};
+    EXPECT_EQ(graph.size(), 0);
+    EXPECT_NO_THROW(graph.run(pool));
+}
+
+TEST(AocTaskGraph, ParseThenParts) {
+    aoc::ThreadPool pool{4};
+    std::vector<int> input{};
+    int sum{};
+    int max{};
+
+    aoc::TaskGraph graph{};
+    auto parse = graph.add([&input] { input = {3, 1, 4, 1, 5}; });
+    auto part1 = graph.add(
+        [&] {
+            for (auto v : input) {
+                sum += v;
+            }
+        },
+        {parse}
+    );
+    auto part2 = graph.add([&] { max = *std::ranges::max_element(input); }, {parse});
+    graph.run(pool);
+
+    EXPECT_EQ(parse, 0);
+    EXPECT_EQ(part1, 1);
+    EXPECT_EQ(part2, 2);
+    EXPECT_EQ(sum, 14);
+    EXPECT_EQ(max, 5);
+}
+
+TEST(AocTaskGraph, SolveConcurrently) {
+    aoc::ThreadPool pool{4};
+    auto [sum, max] = aoc::solve_concurrently(
+        [] { return std::vector<int>{3, 1, 4, 1, 5}; },
+        [](const auto& input) { return std::accumulate(input.begin(), input.end(), 0); },
+        [](const auto& input) { return *std::ranges::max_element(input); },
+        pool
+    );
+    EXPECT_EQ(sum, 14);
+    EXPECT_EQ(max, 5);
+
+    // an input parsed earlier is passed by reference, not copied
+    const std::vector<int> input{2, 7};
+    auto [first, same] = aoc::solve_concurrently(
+        [&input]() -> const std::vector<int>& { return input; },
+        [](const auto& in) { return in.front(); },
+        [&input](const auto& in) { return &in == &input; },
+        pool
+    );
+    EXPECT_EQ(first, 2);
+    EXPECT_TRUE(same);
+}
+
+TEST(AocTaskGraph, DependenciesFinishFirst) {
+    aoc::ThreadPool pool{4};
+    std::mutex mutex{};
+    std::vector<aoc::usize> order{};
+    auto record = [&](aoc::usize id) {
+        return [&, id] {
+            std::lock_guard lock{mutex};
+            order.push_back(id);
+        };
+    };
+
+    // 0 -> {1, 2} -> 3, and 4 only on 0
+    aoc::TaskGraph graph{};
+    auto a = graph.add(record(0));
+    auto b = graph.add(record(1), {a});
+    auto c = graph.add(record(2), {a});
+    graph.add(record(3), {b, c});
+    graph.add(record(4), {a});
+
+    for (int rep = 0; rep < 20; ++rep) {
+        order.clear();
+        graph.run(pool);
+        ASSERT_EQ(order.size(), 5);
+
+        auto pos = [&order](aoc::usize id) {
+            return std::ranges::find(order, id) - order.begin();
+        };
+        EXPECT_EQ(pos(0), 0);
+        EXPECT_LT(pos(1), pos(3));
+        EXPECT_LT(pos(2), pos(3));
+    }
+}
+
+TEST(AocTaskGraph, Exceptions) {
+    aoc::ThreadPool pool{2};
+    std::atomic<int> ran{};
+
+    aoc::TaskGraph graph{};
+    auto fail = graph.add([] { throw std::runtime_error{"parse failed"}; });
+    graph.add([&ran] { ran++; });
+    graph.add([&ran] { ran++; }, {fail});
+
+    EXPECT_THROW(graph.run(pool), std::runtime_error);
+    // the independent task shares the failed one's wave, the dependent one never starts
+    EXPECT_EQ(ran, 1);
+}
@@ -0,0 +1,142 @@
+#include "aoc/thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(AocThreadPool, Size) {
+    EXPECT_EQ(aoc::ThreadPool{1}.size(), 1);
+    EXPECT_EQ(aoc::ThreadPool{4}.size(), 4);
+    EXPECT_GE(aoc::ThreadPool{}.size(), 1);
+}
+
+TEST(AocThreadPool, ParallelFor) {
+    aoc::ThreadPool pool{4};
+
+    for (aoc::usize grain : {0, 1, 7, 1000}) {
+        std::vector<std::atomic<int>> hits(1000);
+        aoc::parallel_for(
+            10, hits.size(), [&hits](aoc::usize i) { hits[i]++; }, grain, pool
+        );
+
+        for (aoc::usize i = 0; i < hits.size(); ++i) {
+            EXPECT_EQ(hits[i], i < 10 ? 0 : 1) << "index " << i << ", grain " << grain;
+        }
+    }
+
+    // empty ranges do nothing
+    aoc::parallel_for(5, 5, [](aoc::usize) { FAIL(); }, 0, pool);
+    aoc::parallel_for(6, 5, [](aoc::usize) { FAIL(); }, 0, pool);
+}
+
+TEST(AocThreadPool, ParallelReduce) {
+    aoc::ThreadPool pool{4};
+
+    auto sum = aoc::parallel_reduce(
+        aoc::usize{1},
+        aoc::usize{10'001},
+        aoc::u64{},
+        [](aoc::usize i) { return aoc::u64{i}; },
+        std::plus<>{},
+        0,
+        pool
+    );
+    EXPECT_EQ(sum, 50'005'000);
+
+    // chunks are combined in order, so a non-commutative reduce still works
+    auto digits = aoc::parallel_reduce(
+        0,
+        10,
+        std::string{},
+        [](aoc::usize i) { return std::to_string(i); },
+        [](std::string a, const std::string& b) { return a + b; },
+        3,
+        pool
+    );
+    EXPECT_EQ(digits, "0123456789");
+
+    // chunk results of `bool` must not share words like `std::vector<bool>` elements do
+    for (aoc::usize hit = 0; hit < 64; ++hit) {
+        auto found = aoc::parallel_reduce(
+            0,
+            64,
+            false,
+            [hit](aoc::usize i) { return i == hit; },
+            [](bool a, bool b) { return a || b; },
+            1,
+            pool
+        );
+        EXPECT_TRUE(found) << hit;
+    }
+
+    EXPECT_EQ(aoc::parallel_reduce(3, 3, 42, [](aoc::usize) { return 0; }, std::plus<>{}), 42);
+}
+
+TEST(AocThreadPool, ParallelSort) {
+    aoc::ThreadPool pool{4};
+    std::mt19937_64 rng{7};
+
+    for (aoc::usize grain : {0, 1, 100, 5000}) {
+        std::vector<int> values(5000);
+        std::ranges::generate(values, [&rng] { return static_cast<int>(rng() % 1000); });
+        auto expected = values;
+        std::ranges::sort(expected, std::greater<>{});
+
+        aoc::parallel_sort(values, std::greater<>{}, grain, pool);
+        EXPECT_EQ(values, expected) << "grain " << grain;
+    }
+
+    std::vector<int> empty{};
+    aoc::parallel_sort(empty, std::ranges::less{}, 0, pool);
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST(AocThreadPool, Nested) {
+    aoc::ThreadPool pool{3};
+
+    // every outer task waits on an inner batch, which only finishes because waiting
+    // threads run tasks themselves
+    std::atomic<int> count{};
+    aoc::parallel_for(
+        0,
+        8,
+        [&](aoc::usize) {
+            aoc::parallel_for(0, 100, [&count](aoc::usize) { count++; }, 1, pool);
+        },
+        1,
+        pool
+    );
+    EXPECT_EQ(count, 800);
+}
+
+TEST(AocThreadPool, Exceptions) {
+    aoc::ThreadPool pool{4};
+
+    std::atomic<int> count{};
+    auto throwing = [&count](aoc::usize i) {
+        count++;
+        if (i == 17) {
+            throw std::runtime_error{"task failed"};
+        }
+    };
+    EXPECT_THROW(aoc::parallel_for(0, 64, throwing, 1, pool), std::runtime_error);
+    // the other tasks still ran, and the pool is usable afterwards
+    EXPECT_EQ(count, 64);
+    EXPECT_EQ(
+        aoc::parallel_reduce(0, 4, 0, [](aoc::usize) { return 1; }, std::plus<>{}, 1, pool), 4
+    );
+}
+
+TEST(AocThreadPool, SingleThreadRunsInline) {
+    aoc::ThreadPool pool{1};
+
+    std::vector<aoc::usize> order{};
+    aoc::parallel_for(0, 5, [&order](aoc::usize i) { order.push_back(i); }, 1, pool);
+    EXPECT_EQ(order, (std::vector<aoc::usize>{0, 1, 2, 3, 4}));
+}
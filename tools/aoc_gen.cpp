@@ -0,0 +1,738 @@
+#include "aoc/aoc.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Writes puzzle inputs of any size for every day, so solvers can be run far beyond the
+// 100-1000 line inputs in `data/`. The same seed and size always give the same bytes on
+// every platform, since the generator does not use the implementation-defined `<random>`
+// distributions or `std::shuffle`.
+//
+// Usage: aoc_gen --day N [--size N] [--seed N] [--output PATH]
+
+namespace {
+
+using aoc::i64;
+using aoc::u32;
+using aoc::u64;
+using aoc::u8;
+using aoc::usize;
+
+constexpr std::string_view USAGE{
+    "Usage: aoc_gen --day N [--size N] [--seed N] [--output PATH]\n"
+    "\n"
+    "Options:\n"
+    "  --day N        day to generate input for\n"
+    "  --size N       input size, its unit depends on the day (see below)\n"
+    "  --seed N       random seed (default 1)\n"
+    "  --output PATH  write to PATH instead of stdout\n"
+    "\n"
+    "Sizes:\n"
+    "  day1, day2, day4, day7, day9   lines (default 1000000)\n"
+    "  day3, day10, day11             grid width and height (default 20000)\n"
+    "  day5                           ranges per map (default 100000)\n"
+    "  day6                           races (default 4)\n"
+    "  day8                           network nodes (default 1000000)\n"
+};
+
+// splitmix64, which is small, fast and fully specified
+class Rng {
+public:
+    explicit Rng(u64 seed) : _state{seed} {}
+
+    u64 next() {
+        u64 z = (_state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // uniform in [0, n), rejecting the low values that would bias the modulo
+    u64 below(u64 n) {
+        AOC_ASSERT(n > 0, "range must not be empty");
+        auto threshold = (0 - n) % n;
+        auto r = next();
+        while (r < threshold) {
+            r = next();
+        }
+        return r % n;
+    }
+
+    // uniform in [lo, hi]
+    i64 range(i64 lo, i64 hi) {
+        return lo + static_cast<i64>(below(static_cast<u64>(hi - lo) + 1));
+    }
+
+    bool chance(double p) {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53 < p;
+    }
+
+    // Fisher-Yates
+    template<std::ranges::random_access_range R>
+    void shuffle(R&& items) {
+        auto first = std::ranges::begin(items);
+        for (auto i = static_cast<u64>(std::ranges::size(items)); i > 1; --i) {
+            std::ranges::iter_swap(first + (i - 1), first + below(i));
+        }
+    }
+
+private:
+    u64 _state{};
+};
+
+// ==========
+// LINE DAYS
+// ==========
+
+void day1(std::ostream& out, u64 lines, Rng& rng) {
+    constexpr std::array<std::string_view, 9> WORDS{
+        "one", "two", "three", "four", "five", "six", "seven", "eight", "nine"};
+
+    std::string line{};
+    for (u64 i = 0; i < lines; ++i) {
+        line.clear();
+        auto tokens = rng.range(1, 12);
+        // every line needs at least one digit, spelled or not
+        auto digit_at = rng.range(0, tokens - 1);
+        for (i64 t = 0; t < tokens; ++t) {
+            auto kind = t == digit_at ? rng.range(0, 1) : rng.range(0, 3);
+            if (kind == 0) {
+                line += static_cast<char>('1' + rng.below(9));
+            } else if (kind == 1) {
+                line += WORDS.at(rng.below(WORDS.size()));
+            } else {
+                line += static_cast<char>('a' + rng.below(26));
+            }
+        }
+        out << line << '\n';
+    }
+}
+
+void day2(std::ostream& out, u64 lines, Rng& rng) {
+    constexpr std::array<std::string_view, 3> COLORS{"red", "green", "blue"};
+
+    std::string line{};
+    for (u64 i = 0; i < lines; ++i) {
+        line = fmt::format("Game {}: ", i + 1);
+        auto sets = rng.range(1, 6);
+        for (i64 s = 0; s < sets; ++s) {
+            if (s > 0) {
+                line += "; ";
+            }
+
+            std::array<usize, 3> order{0, 1, 2};
+            rng.shuffle(order);
+            auto colors = rng.range(1, 3);
+            for (i64 c = 0; c < colors; ++c) {
+                if (c > 0) {
+                    line += ", ";
+                }
+                line += fmt::format("{} {}", rng.range(1, 20), COLORS.at(order.at(c)));
+            }
+        }
+        out << line << '\n';
+    }
+}
+
+void day4(std::ostream& out, u64 lines, Rng& rng) {
+    constexpr usize WINNING = 10;
+    constexpr usize NUMBERS = 25;
+    // the expected number of matches is kept below one, otherwise the number of copies in
+    // part 2 grows exponentially with the card count
+    constexpr std::array<u64, 20> MATCHES{
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 2, 2, 3, 5};
+
+    auto width = fmt::formatted_size("{}", lines);
+    std::array<int, 99> pool{};
+    for (usize i = 0; i < pool.size(); ++i) {
+        pool.at(i) = static_cast<int>(i) + 1;
+    }
+
+    std::string line{};
+    for (u64 i = 0; i < lines; ++i) {
+        // copies must not run past the last card
+        auto matches = std::min<u64>(MATCHES.at(rng.below(MATCHES.size())), lines - i - 1);
+
+        // the first 10 are winning, then non-winning numbers, so picking the mine from
+        // [10 - matches, 35 - matches) gives exactly `matches` shared numbers
+        rng.shuffle(pool);
+        std::array<int, NUMBERS> mine{};
+        std::copy_n(pool.begin() + static_cast<i64>(WINNING - matches), NUMBERS, mine.begin());
+        rng.shuffle(mine);
+
+        line = fmt::format("Card {:>{}}:", i + 1, width);
+        for (usize n = 0; n < WINNING; ++n) {
+            line += fmt::format(" {:>2}", pool.at(n));
+        }
+        line += " |";
+        for (auto n : mine) {
+            line += fmt::format(" {:>2}", n);
+        }
+        out << line << '\n';
+    }
+}
+
+void day6(std::ostream& out, u64 races, Rng& rng) {
+    std::string times{"Time:     "};
+    std::string distances{"Distance: "};
+    for (u64 i = 0; i < races; ++i) {
+        // the record must be beatable, i.e. below (t / 2)^2, and at most 3 digits so the
+        // concatenated record in part 2 stays beatable too
+        auto time = rng.range(10, 99);
+        auto distance = rng.range(1, std::min<i64>(time * time / 4 - 1, 999));
+        auto width =
+            std::max(fmt::formatted_size("{}", time), fmt::formatted_size("{}", distance));
+        times += fmt::format("  {:>{}}", time, width);
+        distances += fmt::format("  {:>{}}", distance, width);
+    }
+    out << times << '\n' << distances << '\n';
+}
+
+void day7(std::ostream& out, u64 lines, Rng& rng) {
+    constexpr std::string_view LABELS{"23456789TJQKA"};
+
+    std::string line{};
+    for (u64 i = 0; i < lines; ++i) {
+        line.clear();
+        for (int c = 0; c < 5; ++c) {
+            line += LABELS.at(rng.below(LABELS.size()));
+        }
+        out << line << ' ' << rng.range(1, 1000) << '\n';
+    }
+}
+
+void day9(std::ostream& out, u64 lines, Rng& rng) {
+    constexpr i64 VALUES = 21;
+
+    std::string line{};
+    std::array<i64, 7> coeffs{};
+    for (u64 i = 0; i < lines; ++i) {
+        // polynomial sequences, so the differences always reach zero
+        auto degree = rng.range(0, static_cast<i64>(coeffs.size()) - 1);
+        for (i64 d = 0; d < static_cast<i64>(coeffs.size()); ++d) {
+            coeffs.at(d) = d <= degree ? rng.range(-5, 5) : 0;
+        }
+
+        line.clear();
+        for (i64 x = 0; x < VALUES; ++x) {
+            i64 value{};
+            for (auto c : std::views::reverse(coeffs)) {
+                value = value * x + c;
+            }
+            if (x > 0) {
+                line += ' ';
+            }
+            line += fmt::to_string(value);
+        }
+        out << line << '\n';
+    }
+}
+
+// =========
+// STRUCTURE
+// =========
+
+void day5(std::ostream& out, u64 ranges, Rng& rng) {
+    constexpr std::array<std::string_view, 7> MAPS{
+        "seed-to-soil",
+        "soil-to-fertilizer",
+        "fertilizer-to-water",
+        "water-to-light",
+        "light-to-temperature",
+        "temperature-to-humidity",
+        "humidity-to-location",
+    };
+    constexpr u64 SPAN = 4'000'000'000;
+    constexpr u64 SEED_PAIRS = 10;
+
+    AOC_ASSERT(ranges > 0 && ranges < SPAN, "range count out of bounds");
+
+    // seed ranges cover about a quarter of the span, so the part 2 search ends quickly
+    out << "seeds:";
+    for (u64 i = 0; i < SEED_PAIRS; ++i) {
+        auto length = rng.range(1, SPAN / (SEED_PAIRS * 4));
+        auto start = rng.below(SPAN - static_cast<u64>(length));
+        out << ' ' << start << ' ' << length;
+    }
+    out << "\n";
+
+    // each map cuts [0, SPAN) into `ranges` pieces and lays them out again in a random
+    // order, which makes it a bijection that is valid in both directions
+    std::vector<u64> cuts{};
+    std::vector<usize> order(ranges);
+    for (auto name : MAPS) {
+        cuts.clear();
+        while (cuts.size() < ranges - 1) {
+            while (cuts.size() < ranges - 1) {
+                cuts.push_back(1 + rng.below(SPAN - 1));
+            }
+            std::ranges::sort(cuts);
+            auto [first, last] = std::ranges::unique(cuts);
+            cuts.erase(first, last);
+        }
+        cuts.insert(cuts.begin(), 0);
+        cuts.push_back(SPAN);
+
+        for (usize i = 0; i < order.size(); ++i) {
+            order.at(i) = i;
+        }
+        rng.shuffle(order);
+
+        std::vector<u64> dst(ranges);
+        u64 next{};
+        for (auto i : order) {
+            dst.at(i) = next;
+            next += cuts.at(i + 1) - cuts.at(i);
+        }
+
+        out << '\n' << name << " map:\n";
+        for (auto i : order) {
+            out << dst.at(i) << ' ' << cuts.at(i) << ' ' << cuts.at(i + 1) - cuts.at(i) << '\n';
+        }
+    }
+}
+
+bool is_prime(u64 n) {
+    if (n < 2) {
+        return false;
+    }
+    for (u64 d = 2; d * d <= n; ++d) {
+        if (n % d == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// `AAA`, `ABA`, ... for ghost starts, `ZZZ`, `ZYZ`, ... for ends, and names ending in
+// neither for every other node
+std::string node_name(u64 index, usize width, char suffix) {
+    std::string name(width, 'A');
+    for (auto it = name.rbegin(); it != name.rend(); ++it) {
+        *it = static_cast<char>('A' + index % 26);
+        index /= 26;
+    }
+    return name + suffix;
+}
+
+void day8(std::ostream& out, u64 nodes, Rng& rng) {
+    // Every ghost walks a cycle of `directions * p` nodes for a distinct prime `p`, with its
+    // end node the last in the cycle. This is the shape the LCM in part 2 relies on. Ghost 0
+    // starts at `AAA` and ends at `ZZZ`, which also makes it the part 1 path.
+    auto ghosts = u64{6};
+    auto directions = std::clamp<u64>(nodes / (ghosts * 10), 2, 263);
+    while (!is_prime(directions)) {
+        directions--;
+    }
+
+    // fewer ghosts for large networks, so the part 2 answer still fits in 64 bits
+    std::vector<u64> primes{};
+    while (true) {
+        primes.clear();
+        auto p = std::max<u64>(2, nodes / (ghosts * directions));
+        while (primes.size() < ghosts) {
+            if (is_prime(p) && p != directions) {
+                primes.push_back(p);
+            }
+            ++p;
+        }
+
+        auto product = directions;
+        bool overflow{};
+        for (auto q : primes) {
+            overflow |= product > std::numeric_limits<u64>::max() / q;
+            product *= q;
+        }
+        if (!overflow || ghosts == 1) {
+            break;
+        }
+        ghosts--;
+    }
+
+    std::string path{};
+    for (u64 i = 0; i < directions; ++i) {
+        path += rng.chance(0.5) ? 'L' : 'R';
+    }
+    out << path << "\n\n";
+
+    u64 total{};
+    for (auto p : primes) {
+        total += directions * p;
+    }
+    usize width{2};
+    for (u64 capacity = 26 * 26; capacity < total; capacity *= 26) {
+        width++;
+    }
+
+    // node `i` of a cycle is left with direction `i % directions`, the other side points
+    // to an earlier node as a decoy
+    u64 id{};
+    std::vector<std::string> names{};
+    for (u64 g = 0; g < primes.size(); ++g) {
+        auto length = directions * primes.at(g);
+        names.clear();
+        names.push_back(g == 0 ? "AAA" : node_name(g, width, 'A'));
+        for (u64 i = 1; i < length; ++i) {
+            names.push_back(node_name(id++, width, 'M'));
+        }
+        names.push_back(g == 0 ? "ZZZ" : node_name(g, width, 'Z'));
+
+        for (u64 i = 0; i < names.size(); ++i) {
+            // the end node continues like the start node does
+            auto step = i == length ? 0 : i;
+            auto next = i == length ? names.at(1) : names.at(i + 1);
+            auto decoy = names.at(rng.below(i + 1));
+            auto left = path.at(step % directions) == 'L';
+            out << fmt::format(
+                "{} = ({}, {})\n", names.at(i), left ? next : decoy, left ? decoy : next
+            );
+        }
+    }
+}
+
+// =====
+// GRIDS
+// =====
+
+void day3(std::ostream& out, u64 size, Rng& rng) {
+    constexpr std::string_view SYMBOLS{"*#+$/@=%&-"};
+
+    std::string line(size, '.');
+    for (u64 y = 0; y < size; ++y) {
+        std::ranges::fill(line, '.');
+        for (u64 x = 0; x < size; ++x) {
+            // numbers of 1 to 3 digits, each followed by at least one non-digit
+            if (rng.chance(0.12)) {
+                auto digits = std::min<u64>(rng.range(1, 3), size - x);
+                line.at(x) = static_cast<char>('1' + rng.below(9));
+                for (u64 d = 1; d < digits; ++d) {
+                    line.at(x + d) = static_cast<char>('0' + rng.below(10));
+                }
+                x += digits;
+            } else if (rng.chance(0.05)) {
+                line.at(x) = SYMBOLS.at(rng.below(SYMBOLS.size()));
+            }
+        }
+        out << line << '\n';
+    }
+}
+
+// The loop goes around a random tree of 4x4 blocks: each block holds a 2x2 cell cycle,
+// cycles of blocks joined by a tree edge are merged into one, so the result is always a
+// single loop. Cells sit on even coordinates with straight pipes in between, which leaves
+// room for tiles inside and outside the loop.
+class LoopMaze {
+public:
+    LoopMaze(u64 size, Rng& rng) : _blocks{std::max<u64>(size / 4, 1)}, _cells(_blocks * _blocks) {
+        // random depth-first growth over about 70% of the blocks
+        auto target = _cells.size() * 7 / 10 + 1;
+        std::vector<u32> stack{static_cast<u32>(rng.below(_cells.size()))};
+        _root = stack.back();
+        _cells.at(_root) |= IN_TREE;
+        usize count{1};
+
+        std::array<u32, 4> candidates{};
+        while (!stack.empty() && count < target) {
+            auto current = stack.back();
+            auto x = current % _blocks;
+            auto y = current / _blocks;
+
+            usize n{};
+            auto consider = [&](u64 cx, u64 cy) {
+                auto idx = static_cast<u32>(cy * _blocks + cx);
+                if ((_cells.at(idx) & IN_TREE) == 0) {
+                    candidates.at(n++) = idx;
+                }
+            };
+            if (x > 0) {
+                consider(x - 1, y);
+            }
+            if (x + 1 < _blocks) {
+                consider(x + 1, y);
+            }
+            if (y > 0) {
+                consider(x, y - 1);
+            }
+            if (y + 1 < _blocks) {
+                consider(x, y + 1);
+            }
+
+            if (n == 0) {
+                stack.pop_back();
+                continue;
+            }
+
+            auto next = candidates.at(rng.below(n));
+            _cells.at(next) |= IN_TREE;
+            // edges are stored on the left/upper block
+            if (next == current + 1) {
+                _cells.at(current) |= EDGE_RIGHT;
+            } else if (next + 1 == current) {
+                _cells.at(next) |= EDGE_RIGHT;
+            } else if (next > current) {
+                _cells.at(current) |= EDGE_DOWN;
+            } else {
+                _cells.at(next) |= EDGE_DOWN;
+            }
+            stack.push_back(next);
+            count++;
+        }
+    }
+
+    [[nodiscard]]
+    u64 extent() const {
+        return _blocks * 4;
+    }
+
+    // top left cell of the first block, which is always on the loop
+    [[nodiscard]]
+    std::pair<u64, u64> start() const {
+        return {(_root % _blocks) * 4, (_root / _blocks) * 4};
+    }
+
+    // the pipe at output position (x, y), or 0 if it is not on the loop
+    [[nodiscard]]
+    char tile(u64 x, u64 y) const {
+        if (x >= extent() || y >= extent()) {
+            return 0;
+        }
+        if (x % 2 == 0 && y % 2 == 0) {
+            return pipe(connections(x / 2, y / 2));
+        }
+        if (y % 2 == 0) {
+            return (connections(x / 2, y / 2) & EAST) != 0 ? '-' : 0;
+        }
+        if (x % 2 == 0) {
+            return (connections(x / 2, y / 2) & SOUTH) != 0 ? '|' : 0;
+        }
+        return 0;
+    }
+
+private:
+    static constexpr u32 IN_TREE = 1;
+    static constexpr u32 EDGE_RIGHT = 2;
+    static constexpr u32 EDGE_DOWN = 4;
+
+    static constexpr u32 NORTH = 1;
+    static constexpr u32 EAST = 2;
+    static constexpr u32 SOUTH = 4;
+    static constexpr u32 WEST = 8;
+
+    static char pipe(u32 dirs) {
+        switch (dirs) {
+            case NORTH | SOUTH:
+                return '|';
+            case EAST | WEST:
+                return '-';
+            case NORTH | EAST:
+                return 'L';
+            case NORTH | WEST:
+                return 'J';
+            case SOUTH | WEST:
+                return '7';
+            case SOUTH | EAST:
+                return 'F';
+            default:
+                return 0;
+        }
+    }
+
+    // connections of loop cell (cx, cy), where each block is 2x2 cells
+    [[nodiscard]]
+    u32 connections(u64 cx, u64 cy) const {
+        auto bx = cx / 2;
+        auto by = cy / 2;
+        auto block = _cells.at(by * _blocks + bx);
+        if ((block & IN_TREE) == 0) {
+            return 0;
+        }
+
+        bool up = by > 0 && (_cells.at((by - 1) * _blocks + bx) & EDGE_DOWN) != 0;
+        bool left = bx > 0 && (_cells.at(by * _blocks + bx - 1) & EDGE_RIGHT) != 0;
+        bool right = (block & EDGE_RIGHT) != 0;
+        bool down = (block & EDGE_DOWN) != 0;
+
+        // a lone block is the cycle TL-TR-BR-BL, a tree edge swaps the two links facing
+        // the neighbor for two links into it
+        switch ((cy % 2) * 2 + cx % 2) {
+            case 0:  // top left
+                return (up ? NORTH : EAST) | (left ? WEST : SOUTH);
+            case 1:  // top right
+                return (up ? NORTH : WEST) | (right ? EAST : SOUTH);
+            case 2:  // bottom left
+                return (left ? WEST : NORTH) | (down ? SOUTH : EAST);
+            default:  // bottom right
+                return (right ? EAST : NORTH) | (down ? SOUTH : WEST);
+        }
+    }
+
+    u64 _blocks{};
+    u32 _root{};
+    std::vector<u8> _cells{};
+};
+
+void day10(std::ostream& out, u64 size, Rng& rng) {
+    constexpr std::string_view JUNK{"|-LJ7F"};
+
+    AOC_ASSERT(size >= 4, "day 10 grids must be at least 4x4");
+    LoopMaze maze{size, rng};
+    auto [sx, sy] = maze.start();
+
+    std::string line(size, '.');
+    for (u64 y = 0; y < size; ++y) {
+        for (u64 x = 0; x < size; ++x) {
+            auto c = maze.tile(x, y);
+            auto near_start = (x > sx ? x - sx : sx - x) + (y > sy ? y - sy : sy - y) <= 1;
+            if (x == sx && y == sy) {
+                c = 'S';
+            } else if (c == 0) {
+                // junk pipes next to the start could make its shape ambiguous
+                c = !near_start && rng.chance(0.5) ? JUNK.at(rng.below(JUNK.size())) : '.';
+            }
+            line.at(x) = c;
+        }
+        out << line << '\n';
+    }
+}
+
+void day11(std::ostream& out, u64 size, Rng& rng) {
+    // about the density of the real input, with a few empty rows and columns to expand
+    std::vector<bool> empty_col(size);
+    for (u64 x = 0; x < size; ++x) {
+        empty_col.at(x) = rng.chance(0.05);
+    }
+
+    std::string line(size, '.');
+    for (u64 y = 0; y < size; ++y) {
+        std::ranges::fill(line, '.');
+        if (!rng.chance(0.05)) {
+            for (u64 x = 0; x < size; ++x) {
+                if (!empty_col.at(x) && rng.chance(0.02)) {
+                    line.at(x) = '#';
+                }
+            }
+        }
+        out << line << '\n';
+    }
+}
+
+// ===
+// CLI
+// ===
+
+struct Generator {
+    u32 day{};
+    u64 default_size{};
+    void (*generate)(std::ostream&, u64, Rng&){};
+};
+
+constexpr std::array<Generator, 11> GENERATORS{{
+    {1, 1'000'000, day1},
+    {2, 1'000'000, day2},
+    {3, 20'000, day3},
+    {4, 1'000'000, day4},
+    {5, 100'000, day5},
+    {6, 4, day6},
+    {7, 1'000'000, day7},
+    {8, 1'000'000, day8},
+    {9, 1'000'000, day9},
+    {10, 20'000, day10},
+    {11, 20'000, day11},
+}};
+
+std::optional<u64> parse_number(std::string_view s) {
+    u64 value{};
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+    if (ec != std::errc{} || ptr != s.data() + s.size()) {
+        return {};
+    }
+    return value;
+}
+
+int fail(std::string_view msg) {
+    fmt::print(stderr, "error: {}\n\n{}", msg, USAGE);
+    return 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::span<char*> args{argv, static_cast<usize>(argc)};
+
+    std::optional<u64> day{};
+    std::optional<u64> size{};
+    u64 seed{1};
+    std::string output{};
+
+    for (usize i = 1; i < args.size(); ++i) {
+        std::string_view arg{args[i]};
+        if (arg == "-h" || arg == "--help") {
+            fmt::print("{}", USAGE);
+            return 0;
+        }
+        if (i + 1 >= args.size()) {
+            return fail(fmt::format("unknown option or missing value: `{}`", arg));
+        }
+        std::string_view value{args[++i]};
+
+        if (arg == "--output") {
+            output = value;
+            continue;
+        }
+
+        auto num = parse_number(value);
+        if (!num.has_value()) {
+            return fail(fmt::format("`{}` expects a number, got `{}`", arg, value));
+        }
+        if (arg == "--day") {
+            day = num;
+        } else if (arg == "--size") {
+            size = num;
+        } else if (arg == "--seed") {
+            seed = *num;
+        } else {
+            return fail(fmt::format("unknown option: `{}`", arg));
+        }
+    }
+
+    if (!day.has_value()) {
+        return fail("missing required option `--day`");
+    }
+    auto gen = std::ranges::find(GENERATORS, *day, &Generator::day);
+    if (gen == GENERATORS.end()) {
+        return fail(fmt::format("day {} is not implemented", *day));
+    }
+    if (size.value_or(1) == 0) {
+        return fail("`--size` must be positive");
+    }
+
+    // a large stream buffer matters when writing hundreds of megabytes
+    std::vector<char> buffer(1 << 20);
+    std::ofstream file{};
+    if (!output.empty()) {
+        file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        file.open(output, std::ios::binary);
+        if (!file) {
+            return fail(fmt::format("cannot open `{}` for writing", output));
+        }
+    } else {
+        std::ios::sync_with_stdio(false);
+    }
+    std::ostream& out = output.empty() ? std::cout : file;
+
+    Rng rng{seed};
+    gen->generate(out, size.value_or(gen->default_size), rng);
+    out.flush();
+    return out ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+# Writes a header with the puzzle inputs as `constexpr` byte arrays, so solvers can read them
+# at compile time. Run in script mode (see `AOC_EMBED_INPUTS` in the top-level CMakeLists.txt):
+#
+#   cmake -DDATA_DIR=data -DDAYS="1,2,3" -DOUTPUT=aoc_inputs.hpp -P embed_inputs.cmake
+#
+# Bytes are written as hex numbers rather than string literals, which keeps them exact (no
+# line ending translation) and avoids the string literal size limits of some compilers.
+
+string(REPLACE "," ";" days "${DAYS}")
+
+set(arrays "")
+set(views "")
+set(cases "")
+foreach(day IN LISTS days)
+    set(path "${DATA_DIR}/day${day}.txt")
+    if(NOT EXISTS "${path}")
+        continue()
+    endif()
+
+    file(READ "${path}" hex HEX)
+    # 16 bytes (32 hex digits) per line
+    string(REGEX REPLACE "(................................)" "\\1\n" bytes "${hex}")
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1, " bytes "${bytes}")
+    string(REPLACE ", \n" ",\n        " bytes "${bytes}")
+
+    string(APPEND arrays "    // data/day${day}.txt\n")
+    string(APPEND arrays "    inline constexpr char day${day}[] = {\n        ${bytes}0x00,\n    };\n\n")
+    string(APPEND views
+        "inline constexpr std::string_view day${day}{details::day${day}, sizeof(details::day${day}) - 1};\n"
+    )
+    string(APPEND cases "        case ${day}:\n            return day${day};\n")
+endforeach()
+
+set(content "// Generated from the `data` directory by `tools/embed_inputs.cmake`, do not edit.
+#pragma once
+
+#include <string_view>
+
+namespace aoc::inputs {
+
+namespace details {
+${arrays}}  // namespace details
+
+${views}
+// input of day `number`, or an empty view if `data/dayN.txt` did not exist
+constexpr std::string_view get(unsigned number) {
+    switch (number) {
+${cases}        default:
+            return {};
+    }
+}
+
+}  // namespace aoc::inputs
+")
+
+# only touch the header when an input changed, so dependents are not rebuilt for nothing
+file(CONFIGURE OUTPUT "${OUTPUT}" CONTENT "${content}" @ONLY)